@@ -0,0 +1,146 @@
+//==============================================================================
+// Shifter FFT Benchmark
+// Runs the RubberBand live shifter, configured as Pitch Drift Brain and
+// Formant Whispers use it, once per compiled-in FFT backend and reports
+// throughput plus how far each backend's output strays from KissFFT's.
+//
+//   cmake -B build -DSCHLOMO_BUILD_BENCHMARKS=ON -DSCHLOMO_RUBBERBAND_FFT=FFTW
+//   cmake --build build --target SchlomoShifterBenchmark
+//   ./build/SchlomoShifterBenchmark [seconds] [sampleRate]
+//==============================================================================
+#include <rubberband/RubberBandLiveShifter.h>
+#include "src/common/FFT.h"  // Backend selection (RubberBand internal API)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+
+    struct Result
+    {
+        std::string backend;
+        double secondsTaken = 0.0;
+        std::vector<float> output;
+    };
+
+    // Deterministic, voice-like input: a gliding harmonic stack with a slow vowel envelope
+    std::vector<float> makeTestSignal(int numSamples, double sampleRate)
+    {
+        std::vector<float> signal((size_t)numSamples);
+        double phase = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = (double)i / sampleRate;
+            const double f0 = 180.0 + 40.0 * std::sin(twoPi * 0.3 * t);
+            phase += twoPi * f0 / sampleRate;
+
+            double sample = 0.0;
+            for (int harmonic = 1; harmonic <= 12; ++harmonic)
+                sample += std::sin(phase * harmonic) / harmonic;
+
+            const double envelope = 0.5 + 0.5 * std::sin(twoPi * 1.7 * t);
+            signal[(size_t)i] = (float)(0.2 * envelope * sample);
+        }
+
+        return signal;
+    }
+
+    Result runBackend(const std::string& backend, const std::vector<float>& input, double sampleRate)
+    {
+        RubberBand::FFT::setDefaultImplementation(backend);
+
+        // Same construction as PitchDriftBrain / FormantWhispers
+        RubberBand::RubberBandLiveShifter shifter((size_t)sampleRate, 1,
+                                                  RubberBand::RubberBandLiveShifter::OptionWindowShort);
+        shifter.setPitchScale(std::pow(2.0, 30.0 / 1200.0));
+
+        const size_t blockSize = shifter.getBlockSize();
+        const size_t numBlocks = input.size() / blockSize;
+
+        Result result;
+        result.backend = backend;
+        result.output.assign(numBlocks * blockSize, 0.0f);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t block = 0; block < numBlocks; ++block)
+        {
+            const float* in = input.data() + block * blockSize;
+            float* out = result.output.data() + block * blockSize;
+            shifter.shift(&in, &out);
+        }
+
+        result.secondsTaken = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    // Signal-to-difference ratio of test against reference, in dB
+    double compare(const std::vector<float>& reference, const std::vector<float>& test, float& maxDifference)
+    {
+        double signalEnergy = 0.0;
+        double differenceEnergy = 0.0;
+        maxDifference = 0.0f;
+
+        for (size_t i = 0; i < std::min(reference.size(), test.size()); ++i)
+        {
+            const float difference = test[i] - reference[i];
+            signalEnergy += (double)reference[i] * reference[i];
+            differenceEnergy += (double)difference * difference;
+            maxDifference = std::max(maxDifference, std::abs(difference));
+        }
+
+        if (differenceEnergy <= 0.0)
+            return INFINITY;
+
+        return 10.0 * std::log10(signalEnergy / differenceEnergy);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 30.0;
+    const double sampleRate = argc > 2 ? std::atof(argv[2]) : 48000.0;
+
+    const auto input = makeTestSignal((int)(seconds * sampleRate), sampleRate);
+
+    // KissFFT first: it is the default build, so it is the reference
+    std::vector<std::string> backends;
+    const auto available = RubberBand::FFT::getImplementations();
+    if (available.count("kissfft") > 0)
+        backends.push_back("kissfft");
+    for (const auto& name : available)
+        if (name != "kissfft")
+            backends.push_back(name);
+
+    std::printf("Shifter benchmark: %.1f s of audio at %.0f Hz, mono, OptionWindowShort\n\n", seconds, sampleRate);
+    std::printf("%-10s %12s %14s %12s %14s\n", "backend", "time (ms)", "x realtime", "SNR (dB)", "max |diff|");
+
+    std::vector<Result> results;
+    for (const auto& backend : backends)
+    {
+        results.push_back(runBackend(backend, input, sampleRate));
+        const auto& result = results.back();
+
+        float maxDifference = 0.0f;
+        const double snr = compare(results.front().output, result.output, maxDifference);
+        const double audioSeconds = (double)result.output.size() / sampleRate;
+
+        std::printf("%-10s %12.1f %14.1f %12.1f %14.2e\n",
+                    result.backend.c_str(),
+                    result.secondsTaken * 1000.0,
+                    audioSeconds / std::max(result.secondsTaken, 1.0e-9),
+                    snr,
+                    (double)maxDifference);
+    }
+
+    return 0;
+}
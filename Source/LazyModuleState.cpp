@@ -0,0 +1,70 @@
+#include "LazyModuleState.h"
+#include <algorithm>
+#include <vector>
+
+//==============================================================================
+// Lazy State Housekeeper
+// One thread per process: every few milliseconds it lets each registered
+// LazyModuleState free what the audio thread retired and build what it asked for.
+//==============================================================================
+class LazyStateHousekeeper : private juce::Thread
+{
+public:
+    static LazyStateHousekeeper& getInstance()
+    {
+        static LazyStateHousekeeper instance;
+        return instance;
+    }
+
+    void add(LazyStateBase* state)
+    {
+        const juce::ScopedLock sl(lock);
+        states.push_back(state);
+
+        if (! isThreadRunning())
+            startThread();
+    }
+
+    // Once this returns, service() is not running on state and never will again
+    void remove(LazyStateBase* state)
+    {
+        const juce::ScopedLock sl(lock);
+        states.erase(std::remove(states.begin(), states.end(), state), states.end());
+    }
+
+private:
+    LazyStateHousekeeper() : juce::Thread("Schlomo Lazy State") {}
+    ~LazyStateHousekeeper() override { stopThread(1000); }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            {
+                const juce::ScopedLock sl(lock);
+                for (auto* state : states)
+                    state->service();
+            }
+
+            wait(pollIntervalMs);
+        }
+    }
+
+    static constexpr int pollIntervalMs = 10;
+
+    juce::CriticalSection lock;
+    std::vector<LazyStateBase*> states;
+};
+
+//==============================================================================
+// LazyStateBase Implementation
+//==============================================================================
+void LazyStateBase::startHousekeeping()
+{
+    LazyStateHousekeeper::getInstance().add(this);
+}
+
+void LazyStateBase::stopHousekeeping()
+{
+    LazyStateHousekeeper::getInstance().remove(this);
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+// Lazy Module State
+// Heavy per-module state (shifters, long delay lines) that only exists while
+// the module is in use, so modules left at zero cost no memory:
+//   - The setter that switches a module on calls build() on its own
+//     (message or control) thread, so the state is there for the next block
+//     and renders do not depend on thread timing.
+//   - process() calls acquire() every block, saying whether the module is
+//     active. Should an active module still find no state (a setter called
+//     before prepare(), say), it raises a request and passes its audio through
+//     until the process-wide housekeeping thread has built it.
+//   - After idleReleaseSeconds of inactive blocks, acquire() hands the state
+//     to a retire slot, which the housekeeping thread empties.
+// The audio thread only loads and stores atomics: it never allocates, frees
+// or waits. State must provide reset().
+class LazyStateBase
+{
+public:
+    virtual ~LazyStateBase() = default;
+
+    static constexpr double idleReleaseSeconds = 10.0;
+
+protected:
+    // Called from the derived constructor/destructor, never while half-built
+    void startHousekeeping();
+    void stopHousekeeping();
+
+    // Housekeeping thread: frees retired state and builds requested state
+    virtual void service() = 0;
+
+    juce::CriticalSection buildLock;  // Held while building and while preparing
+
+private:
+    friend class LazyStateHousekeeper;
+};
+
+//==============================================================================
+template <typename State>
+class LazyModuleState : private LazyStateBase
+{
+public:
+    using Factory = std::function<std::unique_ptr<State>()>;
+
+    LazyModuleState() { startHousekeeping(); }
+
+    ~LazyModuleState() override
+    {
+        stopHousekeeping();
+        delete live.exchange(nullptr);
+        delete retired.exchange(nullptr);
+    }
+
+    // Message thread, audio stopped. rebuild drops state built with the old
+    // settings, otherwise live state is reset and kept. buildNow builds on the
+    // calling thread, so an already-active module has its state from the first block.
+    void prepare(Factory newFactory, double sampleRate, bool rebuild, bool buildNow)
+    {
+        const juce::ScopedLock sl(buildLock);
+
+        factory = std::move(newFactory);
+        idleLimit = juce::jmax(1, (int)(sampleRate * idleReleaseSeconds));
+        idleSamples = 0;
+        requested = false;
+        delete retired.exchange(nullptr);
+
+        if (rebuild)
+            delete live.exchange(nullptr);
+        else if (auto* state = live.load())
+            state->reset();
+
+        if (buildNow && live.load() == nullptr)
+            live.store(factory().release(), std::memory_order_release);
+    }
+
+    // Builds the state now if it is missing. Never from the audio thread:
+    // it allocates and may wait for a build in progress.
+    void build()
+    {
+        const juce::ScopedLock sl(buildLock);
+
+        // Only here (or prepare(), under the same lock) does a null state become a live one
+        if (live.load(std::memory_order_acquire) == nullptr && factory != nullptr)
+            live.store(factory().release(), std::memory_order_release);
+    }
+
+    // The state as it is right now (audio thread, or any thread while audio is stopped)
+    State* get() const noexcept { return live.load(std::memory_order_acquire); }
+
+    // Audio thread, once per block. Returns nullptr while the state is being
+    // built; inactive modules keep theirs until the idle timeout.
+    State* acquire(bool active, int numSamples) noexcept
+    {
+        auto* state = live.load(std::memory_order_acquire);
+
+        if (active)
+        {
+            idleSamples = 0;
+            if (state == nullptr)
+                requested.store(true, std::memory_order_relaxed);
+            return state;
+        }
+
+        if (state == nullptr)
+            return nullptr;
+
+        idleSamples = juce::jmin(idleLimit, idleSamples + numSamples);
+        if (idleSamples < idleLimit || retired.load(std::memory_order_acquire) != nullptr)
+            return state;
+
+        live.store(nullptr, std::memory_order_release);
+        retired.store(state, std::memory_order_release);
+        return nullptr;
+    }
+
+private:
+    void service() override
+    {
+        delete retired.exchange(nullptr, std::memory_order_acq_rel);
+
+        if (requested.exchange(false, std::memory_order_relaxed))
+            build();
+    }
+
+    Factory factory;
+    std::atomic<State*> live { nullptr };
+    std::atomic<State*> retired { nullptr };
+    std::atomic<bool> requested { false };
+    int idleSamples = 0;  // Audio thread only
+    int idleLimit = 1;
+};
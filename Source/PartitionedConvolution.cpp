@@ -0,0 +1,447 @@
+#include "PartitionedConvolution.h"
+
+//==============================================================================
+// ImpulseResponse Implementation
+//==============================================================================
+ImpulseResponse::ImpulseResponse(const juce::AudioBuffer<float>& samples, double rate, const juce::String& irName)
+    : numChannels(juce::jlimit(1, maxChannels, samples.getNumChannels())),
+      lengthInSamples(samples.getNumSamples()),
+      sampleRate(rate),
+      name(irName)
+{
+    // Energy-normalise so every IR sits at roughly the input's level
+    double energy = 0.0;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const float* data = samples.getReadPointer(ch);
+        for (int i = 0; i < lengthInSamples; ++i)
+            energy += (double)data[i] * (double)data[i];
+    }
+
+    const float gain = energy > 0.0 ? (float)(1.0 / std::sqrt(energy / numChannels)) : 0.0f;
+    std::vector<float> scaled((size_t)lengthInSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        juce::FloatVectorOperations::copyWithMultiply(scaled.data(), samples.getReadPointer(ch), gain, lengthInSamples);
+
+        auto& channel = channels[ch];
+        channel.reversedHead.assign(headSize, 0.0f);
+        for (int i = 0; i < juce::jmin(headSize, lengthInSamples); ++i)
+            channel.reversedHead[(size_t)(headSize - 1 - i)] = scaled[(size_t)i];
+
+        partition(channel.shortStage, scaled.data(), juce::jmin(lengthInSamples, longOffset), shortPartition, headSize);
+        partition(channel.longStage, scaled.data(), lengthInSamples, longPartition, longOffset);
+    }
+}
+
+void ImpulseResponse::partition(Stage& stage, const float* taps, int numTaps, int partitionSize, int offset)
+{
+    stage.partitionSize = partitionSize;
+    stage.fftOrder = juce::roundToInt(std::log2(2 * partitionSize));
+    stage.offset = offset;
+    stage.numPartitions = juce::jmax(0, (numTaps - offset + partitionSize - 1) / partitionSize);
+
+    const int fftSize = stage.getFFTSize();
+    const int spectrumSize = stage.getSpectrumSize();
+    stage.spectra.assign((size_t)(stage.numPartitions * spectrumSize), 0.0f);
+
+    juce::dsp::FFT fft(stage.fftOrder);
+    std::vector<float> buffer((size_t)(2 * fftSize));
+
+    // Each partition zero-padded to twice its length, for overlap-save
+    for (int p = 0; p < stage.numPartitions; ++p)
+    {
+        const int start = offset + p * partitionSize;
+        const int count = juce::jmin(partitionSize, numTaps - start);
+
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+        std::copy(taps + start, taps + start + count, buffer.begin());
+        fft.performRealOnlyForwardTransform(buffer.data(), true);
+
+        std::copy(buffer.begin(), buffer.begin() + spectrumSize, stage.spectra.begin() + p * spectrumSize);
+    }
+}
+
+//==============================================================================
+// ImpulseResponseCache Implementation
+//==============================================================================
+namespace
+{
+    // Blackman-windowed sinc with its cutoff just below the lower of the two
+    // Nyquists, so content above the target rate's Nyquist (a 96 kHz IR played
+    // at 48 kHz) is filtered out instead of folding back down as aliases
+    void resampleImpulseResponse(const float* input, int inputLength, float* output, int outputLength, double ratio)
+    {
+        constexpr int zeroCrossings = 16;
+        constexpr double pi = juce::MathConstants<double>::pi;
+        const double cutoff = 0.95 * juce::jmin(1.0, 1.0 / ratio);  // Fraction of the input Nyquist
+        const double halfWidth = zeroCrossings / cutoff;            // In input samples
+
+        for (int i = 0; i < outputLength; ++i)
+        {
+            const double centre = i * ratio;
+            const int first = juce::jmax(0, (int)std::ceil(centre - halfWidth));
+            const int last = juce::jmin(inputLength - 1, (int)std::floor(centre + halfWidth));
+            double sum = 0.0;
+
+            for (int j = first; j <= last; ++j)
+            {
+                const double x = j - centre;
+                const double window = 0.42 + 0.5 * std::cos(pi * x / halfWidth) + 0.08 * std::cos(2.0 * pi * x / halfWidth);
+                const double sinc = x == 0.0 ? 1.0 : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+                sum += input[j] * cutoff * sinc * window;
+            }
+
+            output[i] = (float)sum;
+        }
+    }
+}
+
+std::shared_ptr<const ImpulseResponse> ImpulseResponseCache::load(const juce::File& file, double sampleRate)
+{
+    const juce::String key = "impulse-response|" + file.getFullPathName()
+                           + "|" + juce::String(file.getLastModificationTime().toMilliseconds())
+                           + "|" + juce::String(sampleRate);
+
+    return SharedResourceCache::get<ImpulseResponse>(key, [&file, sampleRate]() -> std::shared_ptr<const ImpulseResponse>
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return nullptr;
+
+        const int numChannels = juce::jmin((int)reader->numChannels, ImpulseResponse::maxChannels);
+        const int fileLength = (int)juce::jmin(reader->lengthInSamples, (juce::int64)(maxLengthSeconds * reader->sampleRate));
+
+        juce::AudioBuffer<float> samples(numChannels, fileLength);
+        reader->read(&samples, 0, fileLength, 0, true, numChannels > 1);
+
+        // Partitions are built at the processing rate
+        if (reader->sampleRate != sampleRate)
+        {
+            const double ratio = reader->sampleRate / sampleRate;
+            const int length = (int)std::ceil(fileLength / ratio);
+            juce::AudioBuffer<float> resampled(numChannels, length);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                resampleImpulseResponse(samples.getReadPointer(ch), fileLength, resampled.getWritePointer(ch), length, ratio);
+
+            samples = std::move(resampled);
+        }
+
+        return std::make_shared<const ImpulseResponse>(samples, sampleRate, file.getFileNameWithoutExtension());
+    });
+}
+
+//==============================================================================
+// PartitionedConvolver Implementation
+//==============================================================================
+void PartitionedConvolver::StageState::prepare(const ImpulseResponse::Stage& stageToUse)
+{
+    stage = &stageToUse;
+
+    if (stage->numPartitions == 0)
+        return;
+
+    // Each convolver runs its own plan: JUCE's fallback FFT engine serialises
+    // perform() on one object, so a shared plan would contend across instances
+    if (fft == nullptr || fft->getSize() != stage->getFFTSize())
+        fft = std::make_unique<juce::dsp::FFT>(stage->fftOrder);
+
+    delayLine.assign((size_t)(stage->numPartitions * stage->getSpectrumSize()), 0.0f);
+    accumulator.assign((size_t)stage->getSpectrumSize(), 0.0f);
+    fftBuffer.assign((size_t)(2 * stage->getFFTSize()), 0.0f);
+}
+
+void PartitionedConvolver::StageState::reset()
+{
+    std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+    std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+    newestSlot = 0;
+}
+
+void PartitionedConvolver::StageState::pushInput(const std::vector<float>& history, int historyEnd, int historyMask)
+{
+    // Overlap-save: transform the latest two partitions' worth of input
+    const int fftSize = stage->getFFTSize();
+    const int start = historyEnd - fftSize;
+
+    for (int i = 0; i < fftSize; ++i)
+        fftBuffer[(size_t)i] = history[(size_t)((start + i) & historyMask)];
+
+    std::fill(fftBuffer.begin() + fftSize, fftBuffer.end(), 0.0f);
+    fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+    const int spectrumSize = stage->getSpectrumSize();
+    newestSlot = (newestSlot + 1) % stage->numPartitions;
+    std::copy(fftBuffer.begin(), fftBuffer.begin() + spectrumSize, delayLine.begin() + newestSlot * spectrumSize);
+}
+
+void PartitionedConvolver::StageState::accumulate(int firstPartition, int endPartition)
+{
+    const int spectrumSize = stage->getSpectrumSize();
+    float* acc = accumulator.data();
+
+    for (int p = firstPartition; p < endPartition; ++p)
+    {
+        // Partition p meets the input block from p blocks ago
+        const int slot = (newestSlot - p + stage->numPartitions) % stage->numPartitions;
+        const float* x = delayLine.data() + slot * spectrumSize;
+        const float* h = stage->getSpectrum(p);
+
+        for (int k = 0; k < spectrumSize; k += 2)
+        {
+            acc[k]     += x[k] * h[k]     - x[k + 1] * h[k + 1];
+            acc[k + 1] += x[k] * h[k + 1] + x[k + 1] * h[k];
+        }
+    }
+}
+
+void PartitionedConvolver::StageState::inverse(float* destination, int destinationMask, int destinationStart)
+{
+    const int spectrumSize = stage->getSpectrumSize();
+    const int partitionSize = stage->partitionSize;
+
+    std::copy(accumulator.begin(), accumulator.end(), fftBuffer.begin());
+    std::fill(fftBuffer.begin() + spectrumSize, fftBuffer.end(), 0.0f);
+    fft->performRealOnlyInverseTransform(fftBuffer.data());
+
+    // The second half is the valid (non-aliased) part
+    for (int i = 0; i < partitionSize; ++i)
+        destination[(destinationStart + i) & destinationMask] = fftBuffer[(size_t)(partitionSize + i)];
+
+    std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+}
+
+PartitionedConvolver::PartitionedConvolver(std::shared_ptr<const ImpulseResponse> ir, int channel)
+    : impulseResponse(std::move(ir)),
+      taps(impulseResponse->getChannel(channel))
+{
+    headHistory.assign(2 * ImpulseResponse::headSize, 0.0f);
+    inputHistory.assign(2 * ImpulseResponse::longPartition, 0.0f);
+    shortOutput.assign(ImpulseResponse::shortPartition, 0.0f);
+    longOutput.assign(2 * ImpulseResponse::longPartition, 0.0f);
+
+    shortStage.prepare(taps.shortStage);
+    longStage.prepare(taps.longStage);
+
+    reset();
+}
+
+void PartitionedConvolver::reset()
+{
+    std::fill(headHistory.begin(), headHistory.end(), 0.0f);
+    std::fill(inputHistory.begin(), inputHistory.end(), 0.0f);
+    std::fill(shortOutput.begin(), shortOutput.end(), 0.0f);
+    std::fill(longOutput.begin(), longOutput.end(), 0.0f);
+
+    shortStage.reset();
+    longStage.reset();
+
+    headPosition = 0;
+    historyPosition = 0;
+    blockFill = 0;
+    longStep = 1;  // The first long block completes after stepsPerLongBlock short blocks
+    outputPosition = 0;
+    longWriteStart = 0;
+}
+
+void PartitionedConvolver::runShortStage()
+{
+    if (shortStage.stage->numPartitions == 0)
+        return;
+
+    shortStage.pushInput(inputHistory, historyPosition, (int)inputHistory.size() - 1);
+    shortStage.accumulate(0, shortStage.stage->numPartitions);
+    shortStage.inverse(shortOutput.data(), ImpulseResponse::shortPartition - 1, 0);
+}
+
+void PartitionedConvolver::runLongStep()
+{
+    const int numPartitions = longStage.stage->numPartitions;
+    if (numPartitions == 0)
+        return;
+
+    const int longMask = (int)longOutput.size() - 1;
+
+    // Step 0: a long block just completed; its result plays one long block from now
+    if (longStep == 0)
+    {
+        longStage.pushInput(inputHistory, historyPosition, (int)inputHistory.size() - 1);
+        longWriteStart = (outputPosition + ImpulseResponse::longPartition) & longMask;
+    }
+
+    // Every step takes an equal share of the partitions, so CPU stays flat
+    constexpr int steps = ImpulseResponse::stepsPerLongBlock;
+    longStage.accumulate(numPartitions * longStep / steps, numPartitions * (longStep + 1) / steps);
+
+    if (longStep == steps - 1)
+        longStage.inverse(longOutput.data(), longMask, longWriteStart);
+
+    longStep = (longStep + 1) % steps;
+}
+
+void PartitionedConvolver::process(const float* input, float* output, int numSamples)
+{
+    constexpr int headSize = ImpulseResponse::headSize;
+    const float* head = taps.reversedHead.data();
+    const int historyMask = (int)inputHistory.size() - 1;
+    const int longMask = (int)longOutput.size() - 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = input[i];
+
+        // Direct-form head: zero latency for the first headSize taps
+        headHistory[(size_t)headPosition] = x;
+        headHistory[(size_t)(headPosition + headSize)] = x;
+        const float* window = headHistory.data() + headPosition + 1;
+
+        float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+        for (int k = 0; k < headSize; k += 4)
+        {
+            sum0 += window[k] * head[k];
+            sum1 += window[k + 1] * head[k + 1];
+            sum2 += window[k + 2] * head[k + 2];
+            sum3 += window[k + 3] * head[k + 3];
+        }
+
+        headPosition = (headPosition + 1) & (headSize - 1);
+
+        inputHistory[(size_t)historyPosition] = x;
+        historyPosition = (historyPosition + 1) & historyMask;
+
+        output[i] = (sum0 + sum1) + (sum2 + sum3) + shortOutput[(size_t)blockFill] + longOutput[(size_t)outputPosition];
+        outputPosition = (outputPosition + 1) & longMask;
+
+        if (++blockFill == ImpulseResponse::shortPartition)
+        {
+            blockFill = 0;
+            runShortStage();
+            runLongStep();
+        }
+    }
+}
+
+//==============================================================================
+// ConvolutionReverb Implementation
+//==============================================================================
+ConvolutionReverb::Mailbox::~Mailbox()
+{
+    delete pending.exchange(nullptr);
+    delete retired.exchange(nullptr);
+}
+
+ConvolutionReverb::ConvolutionReverb()
+    : mailbox(std::make_shared<Mailbox>())
+{
+}
+
+ConvolutionReverb::~ConvolutionReverb()
+{
+    mailbox->latestRequest.fetch_add(1);  // Any job still loading will discard its result
+    delete active;
+    collectRetired(*mailbox);
+}
+
+void ConvolutionReverb::collectRetired(Mailbox& box)
+{
+    delete box.retired.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void ConvolutionReverb::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    fadeBuffer.setSize(ImpulseResponse::maxChannels, samplesPerBlock);
+    collectRetired(*mailbox);
+
+    // Partitions are per sample rate, so a rate change means a reload
+    if (active != nullptr && active->impulseResponse->getSampleRate() != sampleRate && currentFile.existsAsFile())
+        startLoad(currentFile, sampleRate);
+}
+
+void ConvolutionReverb::loadImpulseResponse(const juce::File& file)
+{
+    currentFile = file;
+    collectRetired(*mailbox);
+    startLoad(file, currentSampleRate);
+}
+
+void ConvolutionReverb::startLoad(const juce::File& file, double sampleRate)
+{
+    const int request = mailbox->latestRequest.fetch_add(1) + 1;
+    auto box = mailbox;
+
+    juce::Thread::launch([box, file, sampleRate, request]
+    {
+        auto impulseResponse = ImpulseResponseCache::load(file, sampleRate);
+        if (impulseResponse == nullptr || box->latestRequest.load() != request)
+            return;
+
+        // Everything the audio thread will touch is allocated here
+        auto state = std::make_unique<State>();
+        state->impulseResponse = impulseResponse;
+        for (int ch = 0; ch < ImpulseResponse::maxChannels; ++ch)
+            state->convolvers[ch] = std::make_unique<PartitionedConvolver>(impulseResponse, ch);
+
+        collectRetired(*box);
+        delete box->pending.exchange(state.release(), std::memory_order_acq_rel);  // Drops a superseded, never-played state
+    });
+}
+
+void ConvolutionReverb::reset()
+{
+    if (active != nullptr)
+        for (auto& convolver : active->convolvers)
+            convolver->reset();
+}
+
+bool ConvolutionReverb::hasImpulseResponse() const
+{
+    return active != nullptr || mailbox->pending.load(std::memory_order_acquire) != nullptr;
+}
+
+void ConvolutionReverb::process(const juce::dsp::AudioBlock<const float>& input, juce::AudioBuffer<float>& wet, int numSamples)
+{
+    // Only take a new state once the retire slot is free; only this thread ever fills it
+    State* previous = nullptr;
+    if (mailbox->retired.load(std::memory_order_acquire) == nullptr)
+    {
+        if (auto* next = mailbox->pending.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            previous = active;
+            active = next;
+        }
+    }
+
+    const int numChannels = juce::jmin((int)input.getNumChannels(), wet.getNumChannels(), (int)ImpulseResponse::maxChannels);
+
+    if (active == nullptr)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            wet.clear(ch, 0, numSamples);
+        return;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        active->convolvers[ch]->process(input.getChannelPointer((size_t)ch), wet.getWritePointer(ch), numSamples);
+
+    if (previous != nullptr)
+    {
+        // Crossfade from the old IR over this block, then hand it back for deletion
+        jassert(numSamples <= fadeBuffer.getNumSamples());
+        const int fadeSamples = juce::jmin(numSamples, fadeBuffer.getNumSamples());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            previous->convolvers[ch]->process(input.getChannelPointer((size_t)ch), fadeBuffer.getWritePointer(ch), fadeSamples);
+            wet.applyGainRamp(ch, 0, fadeSamples, 0.0f, 1.0f);
+            wet.addFromWithRamp(ch, 0, fadeBuffer.getReadPointer(ch), fadeSamples, 1.0f, 0.0f);
+        }
+
+        mailbox->retired.store(previous, std::memory_order_release);
+    }
+}
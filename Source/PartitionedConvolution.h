@@ -0,0 +1,188 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "SharedResources.h"
+
+//==============================================================================
+// Partitioned convolution for real bathroom impulse responses
+// Non-uniform partitioning keeps latency at zero and CPU flat for long IRs:
+//   taps [0, 128)      direct-form FIR, computed per sample
+//   taps [128, 2048)   128-sample FFT partitions, run every 128 samples
+//   taps [2048, end)   1024-sample FFT partitions; each block's work is
+//                      spread over the eight 128-sample steps that follow it
+// IRs are prepared once per (file, sample rate) on a loader thread and shared
+// read-only by every instance in the process.
+
+//==============================================================================
+// Impulse Response - immutable, pre-partitioned, shared between instances
+class ImpulseResponse
+{
+public:
+    static constexpr int headSize = 128;
+    static constexpr int shortPartition = 128;
+    static constexpr int longPartition = 1024;
+    static constexpr int longOffset = 2 * longPartition;  // One block of slack for the spread work
+    static constexpr int stepsPerLongBlock = longPartition / shortPartition;
+    static constexpr int maxChannels = 2;
+
+    struct Stage
+    {
+        int partitionSize = 0;
+        int fftOrder = 0;
+        int offset = 0;               // First tap the stage covers
+        int numPartitions = 0;
+        std::vector<float> spectra;   // numPartitions x getSpectrumSize(), juce::dsp::FFT real-only layout
+
+        int getFFTSize() const { return 2 * partitionSize; }
+        int getSpectrumSize() const { return getFFTSize() + 2; }
+        const float* getSpectrum(int partition) const { return spectra.data() + partition * getSpectrumSize(); }
+    };
+
+    struct Channel
+    {
+        std::vector<float> reversedHead;  // First headSize taps, newest-sample-last order
+        Stage shortStage;
+        Stage longStage;
+    };
+
+    // Partitions (and energy-normalises) up to two channels of IR samples
+    ImpulseResponse(const juce::AudioBuffer<float>& samples, double sampleRate, const juce::String& name);
+
+    int getNumChannels() const { return numChannels; }
+    const Channel& getChannel(int channel) const { return channels[juce::jmin(channel, numChannels - 1)]; }
+    int getLengthInSamples() const { return lengthInSamples; }
+    double getSampleRate() const { return sampleRate; }
+    const juce::String& getName() const { return name; }
+
+private:
+    static void partition(Stage& stage, const float* taps, int numTaps, int partitionSize, int offset);
+
+    Channel channels[maxChannels];
+    int numChannels = 0;
+    int lengthInSamples = 0;
+    double sampleRate = 44100.0;
+    juce::String name;
+};
+
+//==============================================================================
+// Impulse Response Cache
+// Process-wide (through SharedResourceCache): instances loading the same file
+// at the same rate get the same ImpulseResponse, freed with its last user.
+// Blocks on file I/O - never call from the audio thread.
+class ImpulseResponseCache
+{
+public:
+    static std::shared_ptr<const ImpulseResponse> load(const juce::File& file, double sampleRate);
+
+    static constexpr double maxLengthSeconds = 10.0;
+};
+
+//==============================================================================
+// Partitioned Convolver - one channel of convolution state for one IR
+// Allocates in the constructor only; process() is allocation- and lock-free.
+class PartitionedConvolver
+{
+public:
+    PartitionedConvolver(std::shared_ptr<const ImpulseResponse> impulseResponse, int channel);
+
+    void reset();
+
+    // Writes the wet signal (replaces the contents of output)
+    void process(const float* input, float* output, int numSamples);
+
+private:
+    struct StageState
+    {
+        const ImpulseResponse::Stage* stage = nullptr;
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::vector<float> delayLine;    // Input spectra, numPartitions slots
+        std::vector<float> accumulator;  // Sum of spectrum products
+        std::vector<float> fftBuffer;    // 2 * fftSize, as juce::dsp::FFT requires
+        int newestSlot = 0;
+
+        void prepare(const ImpulseResponse::Stage& stageToUse);
+        void reset();
+        void pushInput(const std::vector<float>& history, int historyEnd, int historyMask);
+        void accumulate(int firstPartition, int endPartition);
+        void inverse(float* destination, int destinationMask, int destinationStart);
+    };
+
+    void runShortStage();
+    void runLongStep();
+
+    std::shared_ptr<const ImpulseResponse> impulseResponse;  // Keeps the shared IR alive
+    const ImpulseResponse::Channel& taps;
+
+    // Direct-form head: history written twice so the newest headSize samples are contiguous
+    std::vector<float> headHistory;
+    int headPosition = 0;
+
+    // Input history for the FFT stages (power of two, 2 * longPartition)
+    std::vector<float> inputHistory;
+    int historyPosition = 0;
+
+    StageState shortStage;
+    StageState longStage;
+    std::vector<float> shortOutput;  // Plays during the current short block
+    std::vector<float> longOutput;   // Ring of 2 * longPartition
+    int blockFill = 0;
+    int longStep = 0;
+    int outputPosition = 0;
+    int longWriteStart = 0;
+};
+
+//==============================================================================
+// Convolution Reverb - background loading and lock-free swapping
+// loadImpulseResponse() returns at once; a loader thread builds the IR and a
+// fresh set of convolvers and posts them to a mailbox. The audio thread picks
+// them up at the start of a block, crossfades from the old IR over that block
+// and hands the old state back through a single retire slot, which only
+// non-realtime threads empty. Nothing is allocated or freed on the audio thread.
+class ConvolutionReverb
+{
+public:
+    ConvolutionReverb();
+    ~ConvolutionReverb();
+
+    // Message thread
+    void prepare(double sampleRate, int samplesPerBlock);
+    void loadImpulseResponse(const juce::File& file);
+    const juce::File& getImpulseResponseFile() const { return currentFile; }
+
+    // Audio thread
+    void reset();
+    bool hasImpulseResponse() const;
+    void process(const juce::dsp::AudioBlock<const float>& input, juce::AudioBuffer<float>& wet, int numSamples);
+
+private:
+    struct State
+    {
+        std::shared_ptr<const ImpulseResponse> impulseResponse;
+        std::unique_ptr<PartitionedConvolver> convolvers[ImpulseResponse::maxChannels];
+    };
+
+    // Shared with loader jobs, so a job may outlive this object
+    struct Mailbox
+    {
+        ~Mailbox();
+
+        std::atomic<State*> pending { nullptr };
+        std::atomic<State*> retired { nullptr };
+        std::atomic<int> latestRequest { 0 };
+    };
+
+    void startLoad(const juce::File& file, double sampleRate);
+    static void collectRetired(Mailbox& mailbox);
+
+    std::shared_ptr<Mailbox> mailbox;
+    State* active = nullptr;          // Audio thread only
+
+    juce::File currentFile;
+    double currentSampleRate = 44100.0;
+    juce::AudioBuffer<float> fadeBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE(ConvolutionReverb)
+};
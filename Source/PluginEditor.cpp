@@ -35,6 +35,17 @@ SchlomosBathAudioProcessorEditor::SchlomosBathAudioProcessorEditor (SchlomosBath
     addAndMakeVisible(masterMixSlider);
     audioProcessor.getVocalProcessor().setMasterMix(1.0f);
 
+    // Quality tier: Eco for tracking, High for the final mix (ids are tier + 1)
+    qualityBox.addItem("Eco", 1);
+    qualityBox.addItem("Standard", 2);
+    qualityBox.addItem("High", 3);
+    qualityBox.setTooltip("Processing quality: Eco for tracking sessions, High for the final mix");
+    qualityBox.setSelectedId((int)audioProcessor.getVocalProcessor().getQuality() + 1, juce::dontSendNotification);
+    qualityBox.onChange = [this] {
+        audioProcessor.setProcessingQuality((ProcessingQuality)(qualityBox.getSelectedId() - 1));
+    };
+    addAndMakeVisible(qualityBox);
+
     // Enable all modules by default (slider controls amount)
     audioProcessor.getVocalProcessor().getPitchDriftBrain().setEnabled(true);
     audioProcessor.getVocalProcessor().getFormantWhispers().setEnabled(true);
@@ -43,8 +54,13 @@ SchlomosBathAudioProcessorEditor::SchlomosBathAudioProcessorEditor (SchlomosBath
     audioProcessor.getVocalProcessor().getVolumePersonality().setEnabled(true);
     audioProcessor.getVocalProcessor().getPorcelainReflections().setEnabled(true);
     audioProcessor.getVocalProcessor().getSteamModulator().setEnabled(true);
+    audioProcessor.getVocalProcessor().getFaucetFlutter().setEnabled(true);
+    audioProcessor.getVocalProcessor().getDrainResonator().setEnabled(true);
     audioProcessor.getVocalProcessor().getRubberDuckFM().setEnabled(true);
     audioProcessor.getVocalProcessor().getSoapBarGlitch().setEnabled(true);
+    audioProcessor.getVocalProcessor().getBathroomFanChorus().setEnabled(true);
+    audioProcessor.getVocalProcessor().getMildewyWallFilter().setEnabled(true);
+    audioProcessor.getVocalProcessor().getVoiceIdentityBuilder().setEnabled(true);
 
     // Helper to setup sliders
     auto setupSlider = [this](juce::Slider& slider, juce::Label& label) {
@@ -185,11 +201,55 @@ SchlomosBathAudioProcessorEditor::SchlomosBathAudioProcessorEditor (SchlomosBath
         audioProcessor.getVocalProcessor().getPorcelainReflections().setTileScatter((float)porcelainSlider.getValue());
     };
 
+    // Real tub mode: convolve with a bathroom impulse response
+    realTubToggle.setToggleState(audioProcessor.getVocalProcessor().getPorcelainReflections().isConvolutionMode(), juce::dontSendNotification);
+    realTubToggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    realTubToggle.setColour(juce::ToggleButton::tickColourId, juce::Colour(0xffff6600));
+    realTubToggle.onClick = [this] {
+        audioProcessor.getVocalProcessor().getPorcelainReflections().setConvolutionMode(realTubToggle.getToggleState());
+    };
+    addAndMakeVisible(realTubToggle);
+
+    loadImpulseButton.onClick = [this] {
+        impulseChooser = std::make_unique<juce::FileChooser>("Choose a bathroom impulse response",
+                                                             juce::File(), "*.wav;*.aif;*.aiff;*.flac");
+        impulseChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                                    [this](const juce::FileChooser& chooser) {
+            const auto file = chooser.getResult();
+            if (! file.existsAsFile())
+                return;
+
+            auto& reflections = audioProcessor.getVocalProcessor().getPorcelainReflections();
+            reflections.loadImpulseResponse(file);
+            reflections.setConvolutionMode(true);
+            realTubToggle.setToggleState(true, juce::dontSendNotification);
+        });
+    };
+    addAndMakeVisible(loadImpulseButton);
+
+    setupSlider(tubTailSlider, tubTailLabel);
+    tubTailSlider.onValueChange = [this] {
+        auto& reflections = audioProcessor.getVocalProcessor().getPorcelainReflections();
+        const float amount = (float)tubTailSlider.getValue();
+        reflections.setLateLevel(amount);
+        reflections.setTailLength(0.3f + amount * 2.2f);
+    };
+
     setupSlider(steamSlider, steamLabel);
     steamSlider.onValueChange = [this] {
         audioProcessor.getVocalProcessor().getSteamModulator().setHumidity((float)steamSlider.getValue());
     };
 
+    setupSlider(faucetSlider, faucetLabel);
+    faucetSlider.onValueChange = [this] {
+        audioProcessor.getVocalProcessor().getFaucetFlutter().setWaterPressure((float)faucetSlider.getValue());
+    };
+
+    setupSlider(drainSlider, drainLabel);
+    drainSlider.onValueChange = [this] {
+        audioProcessor.getVocalProcessor().getDrainResonator().setResonance((float)drainSlider.getValue());
+    };
+
     // Category 3: Character Modes
     setupSlider(quackSlider, quackLabel);
     quackSlider.onValueChange = [this] {
@@ -201,6 +261,32 @@ SchlomosBathAudioProcessorEditor::SchlomosBathAudioProcessorEditor (SchlomosBath
         audioProcessor.getVocalProcessor().getSoapBarGlitch().setSlipperiness((float)soapSlider.getValue());
     };
 
+    setupSlider(fanSlider, fanLabel);
+    fanSlider.onValueChange = [this] {
+        audioProcessor.getVocalProcessor().getBathroomFanChorus().setFanAmount((float)fanSlider.getValue());
+    };
+
+    setupSlider(mildewSlider, mildewLabel);
+    mildewSlider.onValueChange = [this] {
+        audioProcessor.getVocalProcessor().getMildewyWallFilter().setMildew((float)mildewSlider.getValue());
+    };
+
+    // Category 4: Macro Behavior
+    setupSlider(doublesSlider, doublesLabel);
+    doublesSlider.setRange(0.0, (double)VoiceIdentityBuilder::maxVoices, 1.0);
+    doublesSlider.onValueChange = [this] {
+        audioProcessor.getVocalProcessor().getVoiceIdentityBuilder().setNumVoices((int)doublesSlider.getValue());
+    };
+
+    setupSlider(doubleLevelSlider, doubleLevelLabel);
+    doubleLevelSlider.setValue(0.5);
+    doubleLevelSlider.onValueChange = [this] {
+        audioProcessor.getVocalProcessor().getVoiceIdentityBuilder().setDoubleLevel((float)doubleLevelSlider.getValue());
+    };
+
+    // Background is fully painted from the cache, nothing shows through
+    setOpaque(true);
+
     // Make resizable
     setResizable(true, true);
     setResizeLimits(800, 600, 3840, 2160);
@@ -216,22 +302,40 @@ void SchlomosBathAudioProcessorEditor::timerCallback()
 {
     // Update U-Bend LFO visualizer
     auto& pitchBrain = audioProcessor.getVocalProcessor().getPitchDriftBrain();
-    uBendVisualizer.setPhase(pitchBrain.getLFOPhase());
-    uBendVisualizer.setCurrentValue(pitchBrain.getCurrentCents());
+    uBendVisualizer.setState(pitchBrain.getLFOPhase(), pitchBrain.getCurrentCents());
 
     // Update Formant LFO visualizer
     auto& formantWhispers = audioProcessor.getVocalProcessor().getFormantWhispers();
-    formantVisualizer.setPhase(formantWhispers.getFormantLFOPhase());
-    formantVisualizer.setCurrentValue(formantWhispers.getCurrentFormantShift() * 100.0f);  // Scale for display
+    formantVisualizer.setState(formantWhispers.getFormantLFOPhase(),
+                               formantWhispers.getCurrentFormantShift() * 100.0f);  // Scale for display
 }
 
 //==============================================================================
 void SchlomosBathAudioProcessorEditor::paint (juce::Graphics& g)
 {
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (! backgroundCache.isValid() || scale != backgroundCacheScale)
+        renderBackgroundCache(scale);
+
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+}
+
+void SchlomosBathAudioProcessorEditor::renderBackgroundCache(float scale)
+{
+    auto bounds = getLocalBounds();
+
+    backgroundCacheScale = scale;
+    backgroundCache = juce::Image(juce::Image::RGB,
+                                  juce::jmax(1, juce::roundToInt((float)bounds.getWidth() * scale)),
+                                  juce::jmax(1, juce::roundToInt((float)bounds.getHeight() * scale)),
+                                  false);
+
+    juce::Graphics g(backgroundCache);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // Background gradient
     g.fillAll(juce::Colour(0xff1a1a2e));
 
-    auto bounds = getLocalBounds();
     float width = (float)bounds.getWidth();
     float height = (float)bounds.getHeight();
 
@@ -274,11 +378,14 @@ void SchlomosBathAudioProcessorEditor::paint (juce::Graphics& g)
 
 void SchlomosBathAudioProcessorEditor::resized()
 {
+    backgroundCache = {};  // Rebuilt at the next paint
+
     auto bounds = getLocalBounds();
     auto area = bounds.reduced(20);
 
     // Title area
     titleLabel.setBounds(area.removeFromTop(40));
+    qualityBox.setBounds(titleLabel.getBounds().removeFromRight(110).withSizeKeepingCentre(110, 24));
     subtitleLabel.setBounds(area.removeFromTop(20));
     area.removeFromTop(20);
 
@@ -330,10 +437,25 @@ void SchlomosBathAudioProcessorEditor::resized()
 
     porcelainLabel.setBounds(col2.removeFromTop(20));
     porcelainSlider.setBounds(col2.removeFromTop(25));
+    auto irRow = col2.removeFromTop(22);
+    realTubToggle.setBounds(irRow.removeFromLeft(90));
+    loadImpulseButton.setBounds(irRow.removeFromLeft(90));
+    col2.removeFromTop(5);
+
+    tubTailLabel.setBounds(col2.removeFromTop(20));
+    tubTailSlider.setBounds(col2.removeFromTop(25));
     col2.removeFromTop(5);
 
     steamLabel.setBounds(col2.removeFromTop(20));
     steamSlider.setBounds(col2.removeFromTop(25));
+    col2.removeFromTop(5);
+
+    faucetLabel.setBounds(col2.removeFromTop(20));
+    faucetSlider.setBounds(col2.removeFromTop(25));
+    col2.removeFromTop(5);
+
+    drainLabel.setBounds(col2.removeFromTop(20));
+    drainSlider.setBounds(col2.removeFromTop(25));
 
     // Column 3: Character (right)
     auto col3 = moduleArea.reduced(5);
@@ -345,6 +467,22 @@ void SchlomosBathAudioProcessorEditor::resized()
 
     soapLabel.setBounds(col3.removeFromTop(20));
     soapSlider.setBounds(col3.removeFromTop(25));
+    col3.removeFromTop(5);
+
+    fanLabel.setBounds(col3.removeFromTop(20));
+    fanSlider.setBounds(col3.removeFromTop(25));
+    col3.removeFromTop(5);
+
+    mildewLabel.setBounds(col3.removeFromTop(20));
+    mildewSlider.setBounds(col3.removeFromTop(25));
+    col3.removeFromTop(10);
+
+    doublesLabel.setBounds(col3.removeFromTop(20));
+    doublesSlider.setBounds(col3.removeFromTop(25));
+    col3.removeFromTop(5);
+
+    doubleLevelLabel.setBounds(col3.removeFromTop(20));
+    doubleLevelSlider.setBounds(col3.removeFromTop(25));
 
     // Master mix at bottom center
     auto mixArea = area.removeFromTop(100).withSizeKeepingCentre(150, 100);
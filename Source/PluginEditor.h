@@ -6,39 +6,49 @@
 
 //==============================================================================
 // LFO Visualizer Component - shows sine wave with current phase indicator
+// The background and wave are rendered once into a cached image; per-frame
+// updates only repaint the strips covered by the old and new indicator.
 class LFOVisualizer : public juce::Component
 {
 public:
     LFOVisualizer() = default;
 
-    void setPhase(float newPhase) { phase = newPhase; repaint(); }
-    void setCurrentValue(float value) { currentValue = value; repaint(); }
+    // Update phase and value together so each timer tick causes one repaint
+    void setState(float newPhase, float newValue)
+    {
+        const bool textChanged = std::round(newValue * 10.0f) != std::round(currentValue * 10.0f);
+        if (newPhase == phase && ! textChanged)
+            return;
 
-    void paint(juce::Graphics& g) override
+        repaint(getIndicatorBounds());
+        phase = newPhase;
+        currentValue = newValue;
+        repaint(getIndicatorBounds());
+
+        if (textChanged)
+            repaint(getTextBounds());
+    }
+
+    void setPhase(float newPhase) { setState(newPhase, currentValue); }
+    void setCurrentValue(float value) { setState(phase, value); }
+
+    void resized() override
     {
-        auto bounds = getLocalBounds().toFloat().reduced(2);
+        waveCache = {};  // Rebuilt lazily at the next paint
+    }
 
-        // Background
-        g.setColour(juce::Colour(0xff0a0a15));
-        g.fillRoundedRectangle(bounds, 4.0f);
+    void paint(juce::Graphics& g) override
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (! waveCache.isValid() || scale != waveCacheScale)
+            renderWaveCache(scale);
 
-        // Draw sine wave
-        g.setColour(juce::Colour(0xff00ffff).withAlpha(0.5f));
-        juce::Path wavePath;
+        g.drawImage(waveCache, getLocalBounds().toFloat());
 
+        auto bounds = getWaveBounds();
         float width = bounds.getWidth();
-        float height = bounds.getHeight();
-        float centerY = bounds.getY() + height / 2;
-        float amplitude = height / 2.5f;
-
-        wavePath.startNewSubPath(bounds.getX(), centerY);
-        for (float x = 0; x < width; x += 2)
-        {
-            float normalizedX = x / width;
-            float y = centerY - std::sin(normalizedX * juce::MathConstants<float>::twoPi) * amplitude;
-            wavePath.lineTo(bounds.getX() + x, y);
-        }
-        g.strokePath(wavePath, juce::PathStrokeType(1.5f));
+        float centerY = bounds.getCentreY();
+        float amplitude = bounds.getHeight() / 2.5f;
 
         // Draw current phase position (vertical line)
         float phaseX = bounds.getX() + phase * width;
@@ -47,7 +57,6 @@ public:
 
         // Draw current value indicator (dot on the wave)
         float dotY = centerY - std::sin(phase * juce::MathConstants<float>::twoPi) * amplitude;
-        g.setColour(juce::Colour(0xffff6600));
         g.fillEllipse(phaseX - 4, dotY - 4, 8, 8);
 
         // Draw cents indicator text
@@ -58,8 +67,61 @@ public:
     }
 
 private:
+    juce::Rectangle<float> getWaveBounds() const { return getLocalBounds().toFloat().reduced(2); }
+
+    // Strip covering the phase line and dot
+    juce::Rectangle<int> getIndicatorBounds() const
+    {
+        auto bounds = getWaveBounds();
+        float phaseX = bounds.getX() + phase * bounds.getWidth();
+        return juce::Rectangle<float>(phaseX - 5.0f, 0.0f, 10.0f, (float)getHeight()).getSmallestIntegerContainer();
+    }
+
+    juce::Rectangle<int> getTextBounds() const
+    {
+        return getWaveBounds().toNearestInt().removeFromRight(50).removeFromBottom(14);
+    }
+
+    void renderWaveCache(float scale)
+    {
+        waveCacheScale = scale;
+        waveCache = juce::Image(juce::Image::ARGB,
+                                juce::jmax(1, juce::roundToInt((float)getWidth() * scale)),
+                                juce::jmax(1, juce::roundToInt((float)getHeight() * scale)),
+                                true);
+
+        juce::Graphics g(waveCache);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
+        auto bounds = getWaveBounds();
+
+        // Background
+        g.setColour(juce::Colour(0xff0a0a15));
+        g.fillRoundedRectangle(bounds, 4.0f);
+
+        // Draw sine wave
+        g.setColour(juce::Colour(0xff00ffff).withAlpha(0.5f));
+        juce::Path wavePath;
+
+        float width = bounds.getWidth();
+        float centerY = bounds.getCentreY();
+        float amplitude = bounds.getHeight() / 2.5f;
+
+        wavePath.startNewSubPath(bounds.getX(), centerY);
+        for (float x = 0; x < width; x += 2)
+        {
+            float normalizedX = x / width;
+            float y = centerY - std::sin(normalizedX * juce::MathConstants<float>::twoPi) * amplitude;
+            wavePath.lineTo(bounds.getX() + x, y);
+        }
+        g.strokePath(wavePath, juce::PathStrokeType(1.5f));
+    }
+
     float phase = 0.0f;
     float currentValue = 0.0f;
+
+    juce::Image waveCache;
+    float waveCacheScale = 1.0f;
 };
 
 //==============================================================================
@@ -78,6 +140,7 @@ public:
 
 private:
     void toggleFullscreen();
+    void renderBackgroundCache(float scale);
 
     bool isFullscreen = false;
     int previousWidth = 800;
@@ -92,6 +155,7 @@ private:
     // Master controls
     juce::Label masterMixLabel;
     juce::Slider masterMixSlider;
+    juce::ComboBox qualityBox;
 
     // Parameter sliders with labels
     // Category 1: Human Vocal Randomizers
@@ -126,14 +190,37 @@ private:
     // Category 2: Environmental
     juce::Label porcelainLabel{"", "Porcelain Reflect"};
     juce::Slider porcelainSlider;
+    juce::ToggleButton realTubToggle{"Real Tub"};
+    juce::TextButton loadImpulseButton{"Load IR..."};
+    std::unique_ptr<juce::FileChooser> impulseChooser;
+    juce::Label tubTailLabel{"", "Tub Tail"};
+    juce::Slider tubTailSlider;
     juce::Label steamLabel{"", "Steam/Humidity"};
     juce::Slider steamSlider;
+    juce::Label faucetLabel{"", "Faucet Flutter"};
+    juce::Slider faucetSlider;
+    juce::Label drainLabel{"", "Drain Resonance"};
+    juce::Slider drainSlider;
 
     // Category 3: Character Modes
     juce::Label quackLabel{"", "Rubber Duck"};
     juce::Slider quackSlider;
     juce::Label soapLabel{"", "Soap Glitch"};
     juce::Slider soapSlider;
+    juce::Label fanLabel{"", "Fan Chorus"};
+    juce::Slider fanSlider;
+    juce::Label mildewLabel{"", "Mildewy Walls"};
+    juce::Slider mildewSlider;
+
+    // Category 4: Macro Behavior
+    juce::Label doublesLabel{"", "Voice Doubles"};
+    juce::Slider doublesSlider;
+    juce::Label doubleLevelLabel{"", "Double Level"};
+    juce::Slider doubleLevelSlider;
+
+    // Static background (tub, steam, headers) rendered once per size
+    juce::Image backgroundCache;
+    float backgroundCacheScale = 1.0f;
 
     // Scrollable viewport for controls
     juce::Viewport controlsViewport;
@@ -85,6 +85,17 @@ void SchlomosBathAudioProcessor::changeProgramName (int index, const juce::Strin
 void SchlomosBathAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     vocalProcessor.prepare(sampleRate, samplesPerBlock);
+
+    // The shifter window was just fixed for this run; tell the host what it costs
+    setLatencySamples(vocalProcessor.getLatencySamples());
+}
+
+void SchlomosBathAudioProcessor::setProcessingQuality (ProcessingQuality newQuality)
+{
+    // No prepare here: modules pick the tier up at the next block without
+    // allocating, and the shifter window waits for the host's next prepareToPlay,
+    // which also reports the new latency
+    vocalProcessor.setQuality (newQuality);
 }
 
 void SchlomosBathAudioProcessor::releaseResources()
@@ -116,6 +127,7 @@ bool SchlomosBathAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 
 void SchlomosBathAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    SCHLOMO_REALTIME_SECTION("processBlock");
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -124,6 +136,17 @@ void SchlomosBathAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
+    // Follow the host timeline while playing so random streams line up with
+    // the same sample of the song on every bounce, wherever the render starts
+    if (auto* playHead = getPlayHead())
+        if (auto position = playHead->getPosition())
+            if (position->getIsPlaying())
+                if (auto timeInSamples = position->getTimeInSamples())
+                    vocalProcessor.setRenderPosition((juce::uint64)juce::jmax((juce::int64)0, *timeInSamples));
+
+    // Bounces get the costlier engines; the switch is allocation-free and keeps the reported latency
+    vocalProcessor.setOfflineRendering(isNonRealtime());
+
     // Process through vocal processor
     vocalProcessor.process(buffer);
 }
@@ -142,12 +165,49 @@ juce::AudioProcessorEditor* SchlomosBathAudioProcessor::createEditor()
 //==============================================================================
 void SchlomosBathAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // TODO: Save plugin state
+    // TODO: Save module parameters
+    juce::ValueTree state ("SchlomosBathState");
+    state.setProperty ("seed", (juce::int64) vocalProcessor.getSeed(), nullptr);
+    state.setProperty ("voiceIdentitySeed", (juce::int64) vocalProcessor.getVoiceIdentityBuilder().getIdentitySeed(), nullptr);
+    state.setProperty ("quality", (int) vocalProcessor.getQuality(), nullptr);
+
+    auto& reflections = vocalProcessor.getPorcelainReflections();
+    state.setProperty ("convolutionMode", reflections.isConvolutionMode(), nullptr);
+    if (reflections.getImpulseResponseFile() != juce::File())
+        state.setProperty ("impulseResponse", reflections.getImpulseResponseFile().getFullPathName(), nullptr);
+
+    if (auto xml = state.createXml())
+        copyXmlToBinary (*xml, destData);
 }
 
 void SchlomosBathAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // TODO: Restore plugin state
+    auto xml = getXmlFromBinary (data, sizeInBytes);
+    if (xml == nullptr)
+        return;
+
+    auto state = juce::ValueTree::fromXml (*xml);
+    if (! state.hasType ("SchlomosBathState"))
+        return;
+
+    // Restore the random seed so bounces of this session are reproducible
+    if (state.hasProperty ("seed"))
+        vocalProcessor.setSeed ((juce::uint64) (juce::int64) state.getProperty ("seed"));
+
+    // Restore "This Voice" so doubles keep their character across sessions
+    if (state.hasProperty ("voiceIdentitySeed"))
+        vocalProcessor.getVoiceIdentityBuilder().randomizeIdentities ((juce::uint32) (juce::int64) state.getProperty ("voiceIdentitySeed"));
+
+    if (state.hasProperty ("quality"))
+        setProcessingQuality ((ProcessingQuality) juce::jlimit (0, 2, (int) state.getProperty ("quality")));
+
+    // Real tub mode: the IR reloads in the background
+    auto& reflections = vocalProcessor.getPorcelainReflections();
+    reflections.setConvolutionMode ((bool) state.getProperty ("convolutionMode", false));
+
+    const juce::File impulseResponse (state.getProperty ("impulseResponse").toString());
+    if (impulseResponse.existsAsFile())
+        reflections.loadImpulseResponse (impulseResponse);
 }
 
 //==============================================================================
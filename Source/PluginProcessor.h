@@ -48,6 +48,10 @@ public:
     // Access to vocal processor
     VocalProcessor& getVocalProcessor() { return vocalProcessor; }
 
+    // Message thread: modules switch tier at the next block; the shifter window
+    // and the reported latency follow at the host's next prepareToPlay
+    void setProcessingQuality (ProcessingQuality newQuality);
+
 private:
     //==============================================================================
     VocalProcessor vocalProcessor;
@@ -0,0 +1,284 @@
+#include "RealtimeSafety.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if ! JUCE_WINDOWS
+ #include <cxxabi.h>
+ #include <dlfcn.h>
+#endif
+
+#if SCHLOMO_REALTIME_CHECKS && JUCE_LINUX
+ #include <pthread.h>
+ #include <time.h>
+#endif
+
+//==============================================================================
+// Per-thread section state and the shared violation log
+//==============================================================================
+namespace
+{
+    thread_local int sectionDepth = 0;
+    thread_local const char* currentModule = nullptr;
+    thread_local bool insideReport = false;
+
+    std::atomic<int> numViolations { 0 };
+    RealtimeSafety::Violation violations[RealtimeSafety::maxRecordedViolations];
+
+    const char* getViolationTypeName(RealtimeSafety::ViolationType type)
+    {
+        switch (type)
+        {
+            case RealtimeSafety::ViolationType::Allocation:   return "allocation";
+            case RealtimeSafety::ViolationType::Deallocation: return "deallocation";
+            case RealtimeSafety::ViolationType::Lock:         return "blocking lock";
+            case RealtimeSafety::ViolationType::Sleep:        return "sleep";
+        }
+
+        return "unknown";
+    }
+}
+
+//==============================================================================
+// RealtimeSafety Implementation
+//==============================================================================
+RealtimeSafety::ScopedSection::ScopedSection(const char* sectionName)
+    : previousModule(currentModule),
+      violationsAtEntry(numViolations.load(std::memory_order_relaxed))
+{
+    if (sectionDepth++ == 0)
+        currentModule = sectionName;
+}
+
+RealtimeSafety::ScopedSection::~ScopedSection()
+{
+    currentModule = previousModule;
+
+    if (--sectionDepth > 0)
+        return;
+
+    // Outside the section now, so logging is free to allocate
+    const int total = numViolations.load(std::memory_order_relaxed);
+
+    for (int i = violationsAtEntry; i < total && i < maxRecordedViolations; ++i)
+        juce::Logger::writeToLog("Realtime violation: " + describe(violations[i]));
+
+    if (total > violationsAtEntry)
+        jassertfalse;  // Something inside processBlock allocated, freed or blocked
+}
+
+RealtimeSafety::ScopedModule::ScopedModule(const char* moduleName)
+    : previousModule(currentModule)
+{
+    currentModule = moduleName;
+}
+
+RealtimeSafety::ScopedModule::~ScopedModule()
+{
+    currentModule = previousModule;
+}
+
+bool RealtimeSafety::isInRealtimeSection()
+{
+    return sectionDepth > 0 && ! insideReport;
+}
+
+void RealtimeSafety::reportViolation(ViolationType type, void* callSite)
+{
+    if (! isInRealtimeSection())
+        return;
+
+    insideReport = true;
+
+    const int index = numViolations.fetch_add(1, std::memory_order_relaxed);
+    if (index < maxRecordedViolations)
+        violations[index] = { type, currentModule, callSite };
+
+    insideReport = false;
+}
+
+int RealtimeSafety::getNumViolations()
+{
+    return numViolations.load(std::memory_order_relaxed);
+}
+
+RealtimeSafety::Violation RealtimeSafety::getViolation(int index)
+{
+    if (index < 0 || index >= juce::jmin(getNumViolations(), maxRecordedViolations))
+        return {};
+
+    return violations[index];
+}
+
+void RealtimeSafety::clearViolations()
+{
+    numViolations.store(0, std::memory_order_relaxed);
+}
+
+juce::String RealtimeSafety::describe(const Violation& violation)
+{
+    juce::String site = juce::String::toHexString((juce::pointer_sized_int)violation.callSite);
+
+   #if ! JUCE_WINDOWS
+    Dl_info info;
+    if (violation.callSite != nullptr && dladdr(violation.callSite, &info) != 0 && info.dli_sname != nullptr)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        site = juce::String(status == 0 && demangled != nullptr ? demangled : info.dli_sname);
+        std::free(demangled);
+    }
+   #endif
+
+    return juce::String(getViolationTypeName(violation.type))
+         + " in " + juce::String(violation.module != nullptr ? violation.module : "unknown module")
+         + " at " + site;
+}
+
+#if SCHLOMO_REALTIME_CHECKS
+//==============================================================================
+// Checked global allocation operators
+//==============================================================================
+namespace
+{
+    void* checkedAllocate(std::size_t size, void* callSite)
+    {
+        RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Allocation, callSite);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* checkedAllocateAligned(std::size_t size, std::align_val_t alignment, void* callSite)
+    {
+        RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Allocation, callSite);
+
+        const auto align = juce::jmax((std::size_t)alignment, sizeof(void*));
+       #if JUCE_WINDOWS
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+       #else
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, align, size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+       #endif
+    }
+
+    void checkedFree(void* ptr, void* callSite)
+    {
+        if (ptr == nullptr)
+            return;
+
+        RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Deallocation, callSite);
+        std::free(ptr);
+    }
+
+    void checkedFreeAligned(void* ptr, void* callSite)
+    {
+        if (ptr == nullptr)
+            return;
+
+        RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Deallocation, callSite);
+       #if JUCE_WINDOWS
+        _aligned_free(ptr);
+       #else
+        std::free(ptr);
+       #endif
+    }
+}
+
+#if JUCE_MSVC
+ #include <intrin.h>
+ #define SCHLOMO_CALL_SITE _ReturnAddress()
+#else
+ #define SCHLOMO_CALL_SITE __builtin_return_address(0)
+#endif
+
+void* operator new(std::size_t size)
+{
+    if (auto* ptr = checkedAllocate(size, SCHLOMO_CALL_SITE))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* ptr = checkedAllocate(size, SCHLOMO_CALL_SITE))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept       { return checkedAllocate(size, SCHLOMO_CALL_SITE); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept     { return checkedAllocate(size, SCHLOMO_CALL_SITE); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* ptr = checkedAllocateAligned(size, alignment, SCHLOMO_CALL_SITE))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (auto* ptr = checkedAllocateAligned(size, alignment, SCHLOMO_CALL_SITE))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept                                    { checkedFree(ptr, SCHLOMO_CALL_SITE); }
+void operator delete[](void* ptr) noexcept                                  { checkedFree(ptr, SCHLOMO_CALL_SITE); }
+void operator delete(void* ptr, std::size_t) noexcept                       { checkedFree(ptr, SCHLOMO_CALL_SITE); }
+void operator delete[](void* ptr, std::size_t) noexcept                     { checkedFree(ptr, SCHLOMO_CALL_SITE); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept             { checkedFree(ptr, SCHLOMO_CALL_SITE); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept           { checkedFree(ptr, SCHLOMO_CALL_SITE); }
+void operator delete(void* ptr, std::align_val_t) noexcept                  { checkedFreeAligned(ptr, SCHLOMO_CALL_SITE); }
+void operator delete[](void* ptr, std::align_val_t) noexcept                { checkedFreeAligned(ptr, SCHLOMO_CALL_SITE); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept     { checkedFreeAligned(ptr, SCHLOMO_CALL_SITE); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept   { checkedFreeAligned(ptr, SCHLOMO_CALL_SITE); }
+
+#if JUCE_LINUX
+//==============================================================================
+// Checked blocking calls
+// std::mutex, juce::CriticalSection and juce::WaitableEvent all lock a pthread
+// mutex first, so intercepting the lock entry points covers them. Condition
+// variables are left alone because glibc versions those symbols.
+//==============================================================================
+namespace
+{
+    template <typename FunctionType>
+    FunctionType* findNextSymbol(const char* name)
+    {
+        return reinterpret_cast<FunctionType*>(dlsym(RTLD_NEXT, name));
+    }
+}
+
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Lock, SCHLOMO_CALL_SITE);
+    static auto* next = findNextSymbol<int(pthread_mutex_t*)>("pthread_mutex_lock");
+    return next(mutex);
+}
+
+extern "C" int pthread_rwlock_rdlock(pthread_rwlock_t* lock)
+{
+    RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Lock, SCHLOMO_CALL_SITE);
+    static auto* next = findNextSymbol<int(pthread_rwlock_t*)>("pthread_rwlock_rdlock");
+    return next(lock);
+}
+
+extern "C" int pthread_rwlock_wrlock(pthread_rwlock_t* lock)
+{
+    RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Lock, SCHLOMO_CALL_SITE);
+    static auto* next = findNextSymbol<int(pthread_rwlock_t*)>("pthread_rwlock_wrlock");
+    return next(lock);
+}
+
+extern "C" int nanosleep(const struct timespec* duration, struct timespec* remaining)
+{
+    RealtimeSafety::reportViolation(RealtimeSafety::ViolationType::Sleep, SCHLOMO_CALL_SITE);
+    static auto* next = findNextSymbol<int(const struct timespec*, struct timespec*)>("nanosleep");
+    return next(duration, remaining);
+}
+#endif // JUCE_LINUX
+
+#endif // SCHLOMO_REALTIME_CHECKS
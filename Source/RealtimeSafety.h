@@ -0,0 +1,84 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// Real-time safety checking
+// Configure with -DSCHLOMO_REALTIME_CHECKS=ON to replace the global allocation
+// operators and (on Linux) the pthread lock / sleep entry points with checked
+// versions. Any heap allocation, free or blocking call made on a thread that is
+// inside a realtime section is recorded along with the module that was running
+// and the call site. When the outermost section closes, new violations are
+// logged and a debug assertion fires.
+//
+// Interception only sees calls that resolve to this build's definitions, so it
+// is reliable in executables that link the engine directly (test harnesses,
+// standalone renders) rather than in a plugin loaded by a third-party host.
+class RealtimeSafety
+{
+public:
+    enum class ViolationType
+    {
+        Allocation,
+        Deallocation,
+        Lock,
+        Sleep
+    };
+
+    struct Violation
+    {
+        ViolationType type = ViolationType::Allocation;
+        const char* module = nullptr;  // Module running when the call was made
+        void* callSite = nullptr;      // Return address of the offending call
+    };
+
+    // Marks the calling thread as real-time for the lifetime of the object
+    class ScopedSection
+    {
+    public:
+        explicit ScopedSection(const char* sectionName);
+        ~ScopedSection();
+
+    private:
+        const char* previousModule;
+        int violationsAtEntry;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSection)
+    };
+
+    // Tags the module currently running on this thread for violation reports
+    class ScopedModule
+    {
+    public:
+        explicit ScopedModule(const char* moduleName);
+        ~ScopedModule();
+
+    private:
+        const char* previousModule;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedModule)
+    };
+
+    // True while the calling thread is inside a ScopedSection
+    static bool isInRealtimeSection();
+
+    // Called by the interceptors; lock-free and allocation-free
+    static void reportViolation(ViolationType type, void* callSite);
+
+    // Total violations since the last clear (may exceed the recorded count)
+    static int getNumViolations();
+    static Violation getViolation(int index);
+    static void clearViolations();
+
+    // Human-readable "type in module at symbol" (allocates - not for the audio thread)
+    static juce::String describe(const Violation& violation);
+
+    static constexpr int maxRecordedViolations = 256;
+};
+
+#if SCHLOMO_REALTIME_CHECKS
+ #define SCHLOMO_REALTIME_SECTION(name)  RealtimeSafety::ScopedSection JUCE_JOIN_MACRO(realtimeSection, __LINE__) (name)
+ #define SCHLOMO_REALTIME_MODULE(name)   RealtimeSafety::ScopedModule JUCE_JOIN_MACRO(realtimeModule, __LINE__) (name)
+#else
+ #define SCHLOMO_REALTIME_SECTION(name)
+ #define SCHLOMO_REALTIME_MODULE(name)
+#endif
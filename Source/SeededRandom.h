@@ -0,0 +1,61 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// Seeded Random
+// Counter-based random stream (SplitMix64 finaliser over a keyed counter).
+// Each module/channel derives its own key from the global seed, and the
+// counter is addressed by absolute sample position, so any stream can jump to
+// any point of a render in O(1) and produce the same values it would have
+// produced by running from the start. Up to drawsPerSample values can be taken
+// per sample before they spill into the next sample's slots.
+class SeededRandom
+{
+public:
+    SeededRandom() = default;
+
+    // Derive an independent stream for (module, channel) from the global seed
+    void setSeed(juce::uint64 globalSeed, juce::uint32 streamId, juce::uint32 channel = 0)
+    {
+        key = mix(globalSeed ^ mix(((juce::uint64)streamId << 32) | channel));
+        counter = 0;
+    }
+
+    // Jump-ahead: position the stream at an absolute sample of the render
+    void seekToSample(juce::uint64 samplePosition)
+    {
+        counter = samplePosition << drawBitsPerSample;
+    }
+
+    // Uniform in [0, 1)
+    float nextFloat()
+    {
+        return (float)(nextUInt64() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform in [0, maxValue)
+    int nextInt(int maxValue)
+    {
+        jassert(maxValue > 0);
+        return (int)(((nextUInt64() >> 32) * (juce::uint64)maxValue) >> 32);
+    }
+
+    juce::uint64 nextUInt64()
+    {
+        return mix(key + (++counter) * 0x9e3779b97f4a7c15ull);
+    }
+
+    static constexpr int drawBitsPerSample = 8;
+    static constexpr int drawsPerSample = 1 << drawBitsPerSample;
+
+private:
+    static juce::uint64 mix(juce::uint64 z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    juce::uint64 key = 0;
+    juce::uint64 counter = 0;
+};
@@ -0,0 +1,79 @@
+#include "SharedResources.h"
+#include <map>
+
+//==============================================================================
+// SharedResourceCache Implementation
+//==============================================================================
+namespace
+{
+    struct CacheEntry
+    {
+        juce::CriticalSection buildLock;         // Held while the resource is built
+        std::weak_ptr<const void> resource;      // Written under both locks
+    };
+
+    struct CacheRegistry
+    {
+        juce::CriticalSection lock;
+        std::map<juce::String, std::shared_ptr<CacheEntry>> entries;
+    };
+
+    CacheRegistry& getRegistry()
+    {
+        static CacheRegistry registry;
+        return registry;
+    }
+}
+
+std::shared_ptr<const void> SharedResourceCache::getOrBuild(const juce::String& key,
+                                                            const std::function<std::shared_ptr<const void>()>& build)
+{
+    auto& registry = getRegistry();
+    std::shared_ptr<CacheEntry> entry;
+
+    {
+        const juce::ScopedLock sl(registry.lock);
+        auto& slot = registry.entries[key];
+        if (slot == nullptr)
+            slot = std::make_shared<CacheEntry>();
+
+        if (auto existing = slot->resource.lock())
+            return existing;
+
+        entry = slot;
+    }
+
+    // Only one caller builds a key; the rest wait here and then share its result
+    const juce::ScopedLock building(entry->buildLock);
+
+    {
+        const juce::ScopedLock sl(registry.lock);
+        if (auto existing = entry->resource.lock())
+            return existing;
+    }
+
+    auto resource = build();
+
+    const juce::ScopedLock sl(registry.lock);
+    entry->resource = resource;
+
+    // Drop entries whose resource has gone and that nobody is building
+    for (auto it = registry.entries.begin(); it != registry.entries.end();)
+        it = it->second.use_count() == 1 && it->second->resource.expired() ? registry.entries.erase(it) : std::next(it);
+
+    return resource;
+}
+
+//==============================================================================
+// SharedTables Implementation
+//==============================================================================
+std::shared_ptr<const std::vector<float>> SharedTables::getHannWindow(int size)
+{
+    return SharedResourceCache::get<std::vector<float>>("hann|" + juce::String(size), [size]
+    {
+        auto window = std::make_shared<std::vector<float>>((size_t)size, 0.0f);
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window->data(), (size_t)size,
+                                                                 juce::dsp::WindowingFunction<float>::hann, false);
+        return std::shared_ptr<const std::vector<float>>(std::move(window));
+    });
+}
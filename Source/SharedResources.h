@@ -0,0 +1,41 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Shared Resource Cache
+// Process-wide store for immutable DSP data: window tables, impulse responses
+// and whatever tables or filter kernels come next. FFT objects are not shared:
+// JUCE's fallback engine locks inside perform(), so every user keeps its own.
+// Every instance asking for the same key (which should name the resource, its shape and the
+// sample rate it was built for) gets the same copy. Entries are weak, so a
+// resource is freed with its last user.
+// A missing resource is built once, by the first caller; concurrent callers
+// for that key wait for it. May block - call from prepare() or a loader
+// thread, never from the audio thread.
+class SharedResourceCache
+{
+public:
+    template <typename Resource, typename Builder>
+    static std::shared_ptr<const Resource> get(const juce::String& key, Builder&& build)
+    {
+        return std::static_pointer_cast<const Resource>(getOrBuild(key, [&build]() -> std::shared_ptr<const void>
+        {
+            return std::shared_ptr<const Resource>(build());
+        }));
+    }
+
+private:
+    static std::shared_ptr<const void> getOrBuild(const juce::String& key,
+                                                  const std::function<std::shared_ptr<const void>()>& build);
+};
+
+//==============================================================================
+// Shared Tables - the common cache entries, keyed by their shape
+namespace SharedTables
+{
+    // Symmetric Hann window as juce::dsp::WindowingFunction builds it (size - 1 periods apart)
+    std::shared_ptr<const std::vector<float>> getHannWindow(int size);
+}
@@ -0,0 +1,485 @@
+#include "VocalAnalysis.h"
+
+//==============================================================================
+// SpectralAnalyser Implementation
+//==============================================================================
+void SpectralAnalyser::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    // ~23 ms window at any rate: 1024 @ 44.1/48k, 2048 @ 88.2/96k, 4096 above
+    int fftOrder = 10;
+    if (sampleRate > 64000.0)  ++fftOrder;
+    if (sampleRate > 128000.0) ++fftOrder;
+
+    fftSize = 1 << fftOrder;
+    hopSize = fftSize / 4;
+
+    // Own plan per instance (JUCE's fallback engine locks inside perform()); only the window is shared
+    if (fft == nullptr || fft->getSize() != fftSize)
+        fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+
+    window = SharedTables::getHannWindow(fftSize);
+
+    inputFifo.assign((size_t)fftSize, 0.0f);
+    fftData.assign((size_t)fftSize * 2, 0.0f);
+    previousMagnitudes.assign((size_t)fftSize / 2 + 1, 0.0f);
+
+    reset();
+}
+
+void SpectralAnalyser::reset()
+{
+    std::fill(inputFifo.begin(), inputFifo.end(), 0.0f);
+    std::fill(previousMagnitudes.begin(), previousMagnitudes.end(), 0.0f);
+    fifoWritePos = 0;
+    samplesUntilHop = hopSize;
+    frame = {};
+}
+
+void SpectralAnalyser::process(const float* mono, int numSamples, juce::uint64 blockStartSample)
+{
+    if (fft == nullptr)
+        return;
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        inputFifo[(size_t)fifoWritePos] = mono[sample];
+        fifoWritePos = (fifoWritePos + 1) & (fftSize - 1);
+
+        if (--samplesUntilHop == 0)
+        {
+            analyseHop(blockStartSample + (juce::uint64)sample);
+            samplesUntilHop = hopSize;
+        }
+    }
+}
+
+void SpectralAnalyser::analyseHop(juce::uint64 position)
+{
+    // Unwrap the FIFO (oldest sample first) and apply the window
+    const int firstPart = fftSize - fifoWritePos;
+    juce::FloatVectorOperations::multiply(fftData.data(), inputFifo.data() + fifoWritePos, window->data(), firstPart);
+    juce::FloatVectorOperations::multiply(fftData.data() + firstPart, inputFifo.data(), window->data() + firstPart, fifoWritePos);
+    juce::FloatVectorOperations::clear(fftData.data() + fftSize, fftSize);
+
+    // Time-domain level before the transform overwrites the data
+    float sumSquares = 0.0f;
+    for (int i = 0; i < fftSize; ++i)
+        sumSquares += inputFifo[(size_t)i] * inputFifo[(size_t)i];
+
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    const int numBins = fftSize / 2 + 1;
+    const float binWidthHz = (float)currentSampleRate / (float)fftSize;
+    const float bandEdgesHz[SpectralFrame::numBands - 1] = { 300.0f, 1000.0f, 4000.0f };
+
+    float totalPower = 0.0f;
+    float weightedFrequency = 0.0f;
+    float logPowerSum = 0.0f;
+    float magnitudeSum = 0.0f;
+    float flux = 0.0f;
+    float bandPower[SpectralFrame::numBands] {};
+
+    int band = 0;
+    for (int bin = 1; bin < numBins; ++bin)  // Skip DC
+    {
+        const float magnitude = fftData[(size_t)bin];
+        const float power = magnitude * magnitude + 1.0e-12f;
+        const float frequency = (float)bin * binWidthHz;
+
+        while (band < SpectralFrame::numBands - 1 && frequency >= bandEdgesHz[band])
+            ++band;
+
+        bandPower[band] += power;
+        totalPower += power;
+        weightedFrequency += power * frequency;
+        logPowerSum += std::log(power);
+        magnitudeSum += magnitude;
+        flux += juce::jmax(0.0f, magnitude - previousMagnitudes[(size_t)bin]);
+
+        previousMagnitudes[(size_t)bin] = magnitude;
+    }
+
+    const float numAnalysedBins = (float)(numBins - 1);
+    const float meanPower = totalPower / numAnalysedBins;
+
+    frame.position = position;
+    frame.level = std::sqrt(sumSquares / (float)fftSize);
+    frame.centroidHz = weightedFrequency / totalPower;
+    frame.flatness = juce::jlimit(0.0f, 1.0f, std::exp(logPowerSum / numAnalysedBins) / meanPower);
+    frame.onsetStrength = juce::jlimit(0.0f, 1.0f, flux / (magnitudeSum + 1.0e-6f));
+
+    for (int b = 0; b < SpectralFrame::numBands; ++b)
+        frame.bandEnergy[b] = bandPower[b] / totalPower;
+
+    // Voiced sound is tonal and carries little energy above 4 kHz; gate at -60 dB
+    const float tonality = juce::jlimit(0.0f, 1.0f, 1.0f - 4.0f * frame.flatness);
+    frame.voicing = frame.level > 0.001f ? tonality * (1.0f - frame.bandEnergy[SpectralFrame::High]) : 0.0f;
+}
+
+//==============================================================================
+// PitchTracker Implementation
+//==============================================================================
+namespace
+{
+    // Four independent accumulators so the loop maps onto SIMD lanes
+    float dotProduct(const float* a, const float* b, int length)
+    {
+        float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+        int i = 0;
+
+        for (; i + 4 <= length; i += 4)
+        {
+            sum0 += a[i]     * b[i];
+            sum1 += a[i + 1] * b[i + 1];
+            sum2 += a[i + 2] * b[i + 2];
+            sum3 += a[i + 3] * b[i + 3];
+        }
+
+        for (; i < length; ++i)
+            sum0 += a[i] * b[i];
+
+        return (sum0 + sum1) + (sum2 + sum3);
+    }
+}
+
+void PitchTracker::prepare(double sampleRate)
+{
+    decimationFactor = juce::jmax(1, juce::roundToInt(sampleRate / 11025.0));
+    decimatedRate = sampleRate / decimationFactor;
+
+    minLag = (int)std::floor(decimatedRate / maxFrequencyHz);
+    maxLag = (int)std::ceil(decimatedRate / minFrequencyHz);
+    windowSize = maxLag;       // One period of the lowest pitch
+    hopSize = windowSize / 2;  // ~8 ms
+
+    // Anti-alias below the decimated Nyquist; keeps the low harmonics YIN relies on
+    antiAliasFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, decimatedRate * 0.4, 0.707f);
+    antiAliasFilter.prepare({sampleRate, 1, 1});
+
+    decimatedFifo.assign((size_t)(windowSize + maxLag), 0.0f);
+    analysisBuffer.assign(decimatedFifo.size(), 0.0f);
+    squarePrefix.assign(decimatedFifo.size() + 1, 0.0f);
+    difference.assign((size_t)maxLag + 1, 1.0f);
+
+    reset();
+}
+
+void PitchTracker::reset()
+{
+    antiAliasFilter.reset();
+    std::fill(decimatedFifo.begin(), decimatedFifo.end(), 0.0f);
+    fifoWritePos = 0;
+    decimationCounter = 0;
+    samplesUntilHop = hopSize;
+    estimate = {};
+}
+
+void PitchTracker::process(const float* mono, int numSamples, juce::uint64 blockStartSample)
+{
+    if (decimatedFifo.empty())
+        return;
+
+    const int fifoSize = (int)decimatedFifo.size();
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const float filtered = antiAliasFilter.processSample(mono[sample]);
+
+        if (++decimationCounter < decimationFactor)
+            continue;
+
+        decimationCounter = 0;
+        decimatedFifo[(size_t)fifoWritePos] = filtered;
+        if (++fifoWritePos == fifoSize)
+            fifoWritePos = 0;
+
+        if (--samplesUntilHop == 0)
+        {
+            analyseHop(blockStartSample + (juce::uint64)sample);
+            samplesUntilHop = hopSize;
+        }
+    }
+}
+
+void PitchTracker::analyseHop(juce::uint64 position)
+{
+    // Unwrap the FIFO, oldest sample first
+    const int fifoSize = (int)decimatedFifo.size();
+    const int firstPart = fifoSize - fifoWritePos;
+    std::copy(decimatedFifo.begin() + fifoWritePos, decimatedFifo.end(), analysisBuffer.begin());
+    std::copy(decimatedFifo.begin(), decimatedFifo.begin() + fifoWritePos, analysisBuffer.begin() + firstPart);
+
+    squarePrefix[0] = 0.0f;
+    for (int i = 0; i < fifoSize; ++i)
+        squarePrefix[(size_t)i + 1] = squarePrefix[(size_t)i] + analysisBuffer[(size_t)i] * analysisBuffer[(size_t)i];
+
+    estimate.position = position;
+
+    // Gate silence (-60 dBFS RMS over the window)
+    const float windowEnergy = squarePrefix[(size_t)windowSize];
+    if (windowEnergy < 1.0e-6f * (float)windowSize)
+    {
+        estimate.frequencyHz = 0.0f;
+        estimate.confidence = 0.0f;
+        return;
+    }
+
+    // d(tau) = E(0) + E(tau) - 2 r(tau), then cumulative-mean normalisation
+    const float* x = analysisBuffer.data();
+    float runningSum = 0.0f;
+    difference[0] = 1.0f;
+
+    for (int lag = 1; lag <= maxLag; ++lag)
+    {
+        const float laggedEnergy = squarePrefix[(size_t)(lag + windowSize)] - squarePrefix[(size_t)lag];
+        const float d = juce::jmax(0.0f, windowEnergy + laggedEnergy - 2.0f * dotProduct(x, x + lag, windowSize));
+
+        runningSum += d;
+        difference[(size_t)lag] = runningSum > 0.0f ? d * (float)lag / runningSum : 1.0f;
+    }
+
+    // First dip under the absolute threshold, walked down to its local minimum
+    constexpr float threshold = 0.15f;
+    int bestLag = -1;
+
+    for (int lag = minLag; lag < maxLag; ++lag)
+    {
+        if (difference[(size_t)lag] < threshold)
+        {
+            while (lag + 1 < maxLag && difference[(size_t)lag + 1] < difference[(size_t)lag])
+                ++lag;
+
+            bestLag = lag;
+            break;
+        }
+    }
+
+    // Nothing under the threshold: fall back to the global minimum
+    if (bestLag < 0)
+    {
+        bestLag = minLag;
+        for (int lag = minLag + 1; lag < maxLag; ++lag)
+            if (difference[(size_t)lag] < difference[(size_t)bestLag])
+                bestLag = lag;
+    }
+
+    // Parabolic interpolation around the chosen lag
+    float refinedLag = (float)bestLag;
+    if (bestLag > 1 && bestLag < maxLag)
+    {
+        const float left = difference[(size_t)bestLag - 1];
+        const float centre = difference[(size_t)bestLag];
+        const float right = difference[(size_t)bestLag + 1];
+        const float denominator = left - 2.0f * centre + right;
+
+        if (std::abs(denominator) > 1.0e-9f)
+            refinedLag += juce::jlimit(-0.5f, 0.5f, 0.5f * (left - right) / denominator);
+    }
+
+    estimate.confidence = juce::jlimit(0.0f, 1.0f, 1.0f - difference[(size_t)bestLag]);
+    estimate.frequencyHz = (float)(decimatedRate / refinedLag);
+}
+
+//==============================================================================
+// OnsetDetector Implementation
+//==============================================================================
+namespace
+{
+    float onePoleCoefficient(double sampleRate, double timeOrFrequency, bool isFrequency)
+    {
+        const double seconds = isFrequency ? 1.0 / (juce::MathConstants<double>::twoPi * timeOrFrequency) : timeOrFrequency;
+        return (float)std::exp(-1.0 / (seconds * sampleRate));
+    }
+}
+
+void OnsetDetector::prepare(double sampleRate)
+{
+    lowSplitCoeff = onePoleCoefficient(sampleRate, 300.0, true);
+    highSplitCoeff = onePoleCoefficient(sampleRate, 3000.0, true);
+    fastAttack = onePoleCoefficient(sampleRate, 0.001, false);
+    fastRelease = onePoleCoefficient(sampleRate, 0.015, false);
+    slowAttack = onePoleCoefficient(sampleRate, 0.030, false);
+    slowRelease = onePoleCoefficient(sampleRate, 0.150, false);
+    refractorySamples = (int)(sampleRate * 0.06);
+
+    reset();
+}
+
+void OnsetDetector::reset()
+{
+    lowState = 0.0f;
+    highState = 0.0f;
+    std::fill(std::begin(fastEnvelope), std::end(fastEnvelope), 0.0f);
+    std::fill(std::begin(slowEnvelope), std::end(slowEnvelope), 0.0f);
+    samplesSinceOnset = refractorySamples;
+    aboveThreshold = false;
+}
+
+void OnsetDetector::process(const float* mono, int numSamples, int blockOffset, OnsetEventList& events)
+{
+    constexpr float ratioThreshold = 2.0f;      // +6 dB over the slow envelope
+    constexpr float rearmThreshold = 1.25f;     // Must settle back before the next onset
+    constexpr float levelFloor = 0.003f;        // Ignore anything under ~-50 dBFS
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const float input = mono[sample];
+
+        // Band split: low = LP 300, high = input - LP 3k, mid = the rest
+        lowState = input + lowSplitCoeff * (lowState - input);
+        highState = input + highSplitCoeff * (highState - input);
+        const float bands[numBands] = { lowState, highState - lowState, input - highState };
+
+        float maxLevel = 0.0f;
+
+        for (int b = 0; b < numBands; ++b)
+        {
+            const float rectified = std::abs(bands[b]);
+            const float fastCoeff = rectified > fastEnvelope[b] ? fastAttack : fastRelease;
+            fastEnvelope[b] = rectified + fastCoeff * (fastEnvelope[b] - rectified);
+            const float slowCoeff = rectified > slowEnvelope[b] ? slowAttack : slowRelease;
+            slowEnvelope[b] = rectified + slowCoeff * (slowEnvelope[b] - rectified);
+            maxLevel = juce::jmax(maxLevel, fastEnvelope[b]);
+        }
+
+        // Only bands carrying a real share of the signal may trigger
+        const float bandFloor = juce::jmax(levelFloor, maxLevel * 0.25f);
+        float maxRatio = 0.0f;
+
+        for (int b = 0; b < numBands; ++b)
+            if (fastEnvelope[b] > bandFloor)
+                maxRatio = juce::jmax(maxRatio, fastEnvelope[b] / (slowEnvelope[b] + 1.0e-6f));
+
+        ++samplesSinceOnset;
+
+        if (aboveThreshold && maxRatio < rearmThreshold)
+            aboveThreshold = false;
+
+        if (maxRatio > ratioThreshold && ! aboveThreshold && samplesSinceOnset >= refractorySamples)
+        {
+            // Strength blends how sudden the jump was with how loud it is (-50..-10 dBFS)
+            const float sharpness = juce::jlimit(0.0f, 1.0f, (maxRatio - ratioThreshold) / (2.0f * ratioThreshold));
+            const float loudness = juce::jlimit(0.0f, 1.0f, (juce::Decibels::gainToDecibels(maxLevel) + 50.0f) / 40.0f);
+            events.add(blockOffset + sample, 0.5f * (sharpness + loudness));
+            samplesSinceOnset = 0;
+            aboveThreshold = true;
+        }
+    }
+}
+
+//==============================================================================
+// EnvelopeFollower Implementation
+//==============================================================================
+void EnvelopeFollower::prepare(double sampleRate, int samplesPerBlock)
+{
+    const float peakAttack = onePoleCoefficient(sampleRate, 0.005, false);
+    const float peakRelease = onePoleCoefficient(sampleRate, 0.120, false);
+    const float meanSquare = onePoleCoefficient(sampleRate, 0.025, false);
+
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        attackCoeffs[ch] = peakAttack;
+        releaseCoeffs[ch] = peakRelease;
+        attackCoeffs[maxChannels + ch] = meanSquare;
+        releaseCoeffs[maxChannels + ch] = meanSquare;
+    }
+
+    peakBuffer.setSize(maxChannels, juce::jmax(1, samplesPerBlock));
+    rmsBuffer.setSize(maxChannels, juce::jmax(1, samplesPerBlock));
+
+    reset();
+}
+
+void EnvelopeFollower::reset()
+{
+    std::fill(std::begin(state), std::end(state), 0.0f);
+    peakBuffer.clear();
+    rmsBuffer.clear();
+    numSamples = 0;
+}
+
+void EnvelopeFollower::process(const juce::dsp::AudioBlock<const float>& block)
+{
+    const int numChannels = (int)block.getNumChannels();
+    if (numChannels == 0)
+        return;
+
+    jassert((int)block.getNumSamples() <= peakBuffer.getNumSamples());
+    numSamples = juce::jmin((int)block.getNumSamples(), peakBuffer.getNumSamples());
+
+    // Mono input feeds both lanes
+    const float* left = block.getChannelPointer(0);
+    const float* right = block.getChannelPointer((size_t)juce::jmin(1, numChannels - 1));
+    float* peakOut[maxChannels] = { peakBuffer.getWritePointer(0), peakBuffer.getWritePointer(1) };
+    float* rmsOut[maxChannels] = { rmsBuffer.getWritePointer(0), rmsBuffer.getWritePointer(1) };
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        alignas(16) const float input[numLanes] = { std::abs(left[sample]), std::abs(right[sample]),
+                                                    left[sample] * left[sample], right[sample] * right[sample] };
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const float coeff = input[lane] > state[lane] ? attackCoeffs[lane] : releaseCoeffs[lane];
+            state[lane] = input[lane] + coeff * (state[lane] - input[lane]);
+        }
+
+        for (int ch = 0; ch < maxChannels; ++ch)
+        {
+            peakOut[ch][sample] = state[ch];
+            rmsOut[ch][sample] = std::sqrt(state[maxChannels + ch]);
+        }
+    }
+}
+
+//==============================================================================
+// VocalAnalysis Implementation
+//==============================================================================
+void VocalAnalysis::prepare(double sampleRate, int samplesPerBlock)
+{
+    monoBuffer.assign((size_t)juce::jmax(1, samplesPerBlock), 0.0f);
+    spectralAnalyser.prepare(sampleRate);
+    pitchTracker.prepare(sampleRate);
+    onsetDetector.prepare(sampleRate);
+    envelopeFollower.prepare(sampleRate, samplesPerBlock);
+}
+
+void VocalAnalysis::reset()
+{
+    spectralAnalyser.reset();
+    pitchTracker.reset();
+    onsetDetector.reset();
+    onsets.clear();
+    envelopeFollower.reset();
+}
+
+void VocalAnalysis::process(const juce::dsp::AudioBlock<const float>& block, juce::uint64 blockStartSample)
+{
+    onsets.clear();
+
+    const int numChannels = (int)block.getNumChannels();
+    if (numChannels == 0 || monoBuffer.empty())
+        return;
+
+    envelopeFollower.process(block);
+
+    const float channelGain = 1.0f / (float)numChannels;
+    const int chunkSize = (int)monoBuffer.size();
+
+    // Downmix once, in chunks if the host sends more than it announced
+    for (int start = 0; start < (int)block.getNumSamples(); start += chunkSize)
+    {
+        const int numSamples = juce::jmin(chunkSize, (int)block.getNumSamples() - start);
+        const juce::uint64 chunkPosition = blockStartSample + (juce::uint64)start;
+
+        juce::FloatVectorOperations::copyWithMultiply(monoBuffer.data(), block.getChannelPointer(0) + start, channelGain, numSamples);
+        for (int channel = 1; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply(monoBuffer.data(), block.getChannelPointer((size_t)channel) + start, channelGain, numSamples);
+
+        spectralAnalyser.process(monoBuffer.data(), numSamples, chunkPosition);
+        pitchTracker.process(monoBuffer.data(), numSamples, chunkPosition);
+        onsetDetector.process(monoBuffer.data(), numSamples, start, onsets);
+    }
+}
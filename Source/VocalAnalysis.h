@@ -0,0 +1,232 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include "SharedResources.h"
+
+//==============================================================================
+// Shared analysis of the incoming vocal
+// VocalProcessor runs this once per block, before any module, and hands every
+// module a const reference to the results. Modules read the same features
+// instead of each running their own detectors.
+
+//==============================================================================
+// One hop's worth of spectral features (Vowel/Consonant IQ)
+struct SpectralFrame
+{
+    // Band edges: < 300 Hz (chest/plosive thump), 300-1k (F1 vowel),
+    // 1k-4k (F2/presence), > 4k (sibilance/air)
+    enum Band { Low, LowMid, HighMid, High, numBands };
+
+    float level = 0.0f;              // RMS of the analysed window
+    float centroidHz = 0.0f;         // Spectral centroid
+    float bandEnergy[numBands] {};   // Fraction of total energy per band (sums to 1)
+    float flatness = 0.0f;           // 0 = tonal, 1 = noise-like
+    float onsetStrength = 0.0f;      // Positive spectral flux, normalised to 0..1
+    float voicing = 0.0f;            // 0 = unvoiced/silent, 1 = clearly voiced
+    juce::uint64 position = 0;       // Render position of the hop that produced it
+};
+
+//==============================================================================
+// Spectral Analyser
+// Mono downmix -> Hann-windowed FFT every hop -> SpectralFrame. The window is
+// ~23 ms at any sample rate with 75% overlap; only the latest frame is kept.
+class SpectralAnalyser
+{
+public:
+    SpectralAnalyser() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+    void process(const float* mono, int numSamples, juce::uint64 blockStartSample);
+
+    const SpectralFrame& getFrame() const { return frame; }
+
+private:
+    void analyseHop(juce::uint64 position);
+
+    double currentSampleRate = 44100.0;
+    int fftSize = 1024;
+    int hopSize = 256;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::shared_ptr<const std::vector<float>> window;
+    std::vector<float> inputFifo;       // Circular, fftSize long
+    std::vector<float> fftData;         // 2 * fftSize, as juce::dsp::FFT requires
+    std::vector<float> previousMagnitudes;
+    int fifoWritePos = 0;
+    int samplesUntilHop = 0;
+
+    SpectralFrame frame;
+};
+
+//==============================================================================
+// Latest pitch estimate
+struct PitchEstimate
+{
+    float frequencyHz = 0.0f;        // 0 when nothing periodic was found
+    float confidence = 0.0f;         // 1 - YIN aperiodicity at the chosen lag
+    juce::uint64 position = 0;       // Render position of the hop that produced it
+};
+
+//==============================================================================
+// Pitch Tracker
+// YIN on audio decimated to ~11 kHz, covering 60 Hz - 1 kHz. The difference
+// function is built from running energies and one dot product per lag, so a
+// hop costs a fixed (lags x window) multiply-adds regardless of the input.
+class PitchTracker
+{
+public:
+    PitchTracker() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+    void process(const float* mono, int numSamples, juce::uint64 blockStartSample);
+
+    const PitchEstimate& getEstimate() const { return estimate; }
+
+    static constexpr float minFrequencyHz = 60.0f;
+    static constexpr float maxFrequencyHz = 1000.0f;
+
+private:
+    void analyseHop(juce::uint64 position);
+
+    double decimatedRate = 11025.0;
+    int decimationFactor = 4;
+    int decimationCounter = 0;
+    int minLag = 11;
+    int maxLag = 184;
+    int windowSize = 184;
+    int hopSize = 96;
+    int samplesUntilHop = 0;
+
+    juce::dsp::IIR::Filter<float> antiAliasFilter;
+    std::vector<float> decimatedFifo;     // Circular, windowSize + maxLag long
+    std::vector<float> analysisBuffer;    // FIFO unwrapped, oldest first
+    std::vector<float> squarePrefix;      // Running sum of squares over analysisBuffer
+    std::vector<float> difference;        // YIN cumulative-mean-normalised difference
+    int fifoWritePos = 0;
+
+    PitchEstimate estimate;
+};
+
+//==============================================================================
+// Onset events for the current block, sample-accurate and preallocated
+struct OnsetEvent
+{
+    int sampleOffset = 0;            // Offset from the start of the block
+    float strength = 0.0f;           // 0..1, how hard the syllable hit
+};
+
+struct OnsetEventList
+{
+    static constexpr int maxEvents = 64;
+
+    void clear() { numEvents = 0; }
+    void add(int sampleOffset, float strength)
+    {
+        if (numEvents < maxEvents)
+            events[numEvents++] = { sampleOffset, strength };
+    }
+
+    int size() const { return numEvents; }
+    const OnsetEvent& operator[](int index) const { return events[index]; }
+    const OnsetEvent* begin() const { return events; }
+    const OnsetEvent* end() const { return events + numEvents; }
+
+private:
+    OnsetEvent events[maxEvents];
+    int numEvents = 0;
+};
+
+//==============================================================================
+// Onset Detector
+// Three bands (< 300 Hz, 300 Hz - 3 kHz, > 3 kHz) split with one-pole filters,
+// each with a fast and a slow peak envelope. An onset fires when any band's
+// fast envelope jumps 6 dB above its slow one; the detector re-arms once the
+// two settle back together, with a 60 ms minimum gap between onsets.
+class OnsetDetector
+{
+public:
+    OnsetDetector() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+    void process(const float* mono, int numSamples, int blockOffset, OnsetEventList& events);
+
+private:
+    static constexpr int numBands = 3;
+
+    float lowSplitCoeff = 0.0f;
+    float highSplitCoeff = 0.0f;
+    float fastAttack = 0.0f, fastRelease = 0.0f;
+    float slowAttack = 0.0f, slowRelease = 0.0f;
+    int refractorySamples = 0;
+
+    float lowState = 0.0f;
+    float highState = 0.0f;
+    float fastEnvelope[numBands] {};
+    float slowEnvelope[numBands] {};
+    int samplesSinceOnset = 0;
+    bool aboveThreshold = false;
+};
+
+//==============================================================================
+// Envelope Follower
+// Per-channel peak (5 ms attack / 120 ms release) and RMS (~25 ms) envelopes
+// for every sample of the block, computed once for all modules. The stereo
+// peak and mean-square states share one four-lane vector, so the per-sample
+// update is a single branch-free 4-wide step the compiler keeps in a register.
+class EnvelopeFollower
+{
+public:
+    EnvelopeFollower() = default;
+
+    static constexpr int maxChannels = 2;
+
+    void prepare(double sampleRate, int samplesPerBlock);
+    void reset();
+    void process(const juce::dsp::AudioBlock<const float>& block);
+
+    // Valid for the first getNumSamples() samples of the current block
+    int getNumSamples() const { return numSamples; }
+    const float* getPeak(int channel) const { return peakBuffer.getReadPointer(juce::jmin(channel, maxChannels - 1)); }
+    const float* getRms(int channel) const { return rmsBuffer.getReadPointer(juce::jmin(channel, maxChannels - 1)); }
+
+private:
+    // Lanes: [peak L, peak R, mean-square L, mean-square R]
+    static constexpr int numLanes = 2 * maxChannels;
+
+    alignas(16) float state[numLanes] {};
+    alignas(16) float attackCoeffs[numLanes] {};
+    alignas(16) float releaseCoeffs[numLanes] {};
+
+    juce::AudioBuffer<float> peakBuffer;
+    juce::AudioBuffer<float> rmsBuffer;
+    int numSamples = 0;
+};
+
+//==============================================================================
+// Vocal Analysis - the per-instance analysis stage
+class VocalAnalysis
+{
+public:
+    VocalAnalysis() = default;
+
+    void prepare(double sampleRate, int samplesPerBlock);
+    void reset();
+    void process(const juce::dsp::AudioBlock<const float>& block, juce::uint64 blockStartSample);
+
+    const SpectralFrame& getSpectralFrame() const { return spectralAnalyser.getFrame(); }
+    const PitchEstimate& getPitch() const { return pitchTracker.getEstimate(); }
+    const OnsetEventList& getOnsets() const { return onsets; }
+    const EnvelopeFollower& getEnvelopes() const { return envelopeFollower; }
+
+private:
+    std::vector<float> monoBuffer;  // Downmix shared by every analyser
+    SpectralAnalyser spectralAnalyser;
+    PitchTracker pitchTracker;
+    OnsetDetector onsetDetector;
+    OnsetEventList onsets;
+    EnvelopeFollower envelopeFollower;
+};
@@ -1,5 +1,101 @@
 #include "VocalProcessor.h"
 
+//==============================================================================
+// ShifterBank Implementation
+//==============================================================================
+ShifterBank::ShifterBank(double sampleRate, RubberBand::RubberBandLiveShifter::Options options)
+{
+    for (auto& shifter : shifters)
+        shifter = std::make_unique<RubberBand::RubberBandLiveShifter>(
+            (size_t)sampleRate,
+            1,  // mono per channel
+            options
+        );
+
+    rbBlockSize = shifters[0]->getBlockSize();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        inputBuffers[ch].assign(rbBlockSize, 0.0f);
+        outputBuffers[ch].assign(rbBlockSize, 0.0f);
+        // FIFO needs to hold at least 2 blocks worth of samples
+        outputFIFOs[ch].assign(rbBlockSize * 4, 0.0f);
+    }
+}
+
+int ShifterBank::getLatencySamples(double sampleRate, RubberBand::RubberBandLiveShifter::Options options)
+{
+    // A block is shifted once its last input sample arrives, and that sample's
+    // iteration already reads the block's first output
+    const RubberBand::RubberBandLiveShifter probe((size_t)sampleRate, 1, options);
+    return (int)(probe.getBlockSize() - 1 + probe.getStartDelay());
+}
+
+void ShifterBank::reset()
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        resetChannel(ch);
+        std::fill(inputBuffers[ch].begin(), inputBuffers[ch].end(), 0.0f);
+        std::fill(outputBuffers[ch].begin(), outputBuffers[ch].end(), 0.0f);
+    }
+}
+
+void ShifterBank::resetChannel(int channel)
+{
+    shifters[channel]->reset();
+    std::fill(outputFIFOs[channel].begin(), outputFIFOs[channel].end(), 0.0f);
+    inputPos[channel] = 0;
+    outputPos[channel] = 0;
+    outputAvailable[channel] = 0;
+}
+
+void ShifterBank::process(int channel, float* channelData, int numSamples)
+{
+    auto& shifter = shifters[channel];
+    auto& inputBuf = inputBuffers[channel];
+    auto& outputBuf = outputBuffers[channel];
+    auto& outputFIFO = outputFIFOs[channel];
+    size_t& inPos = inputPos[channel];
+    size_t& outPos = outputPos[channel];
+    size_t& outAvail = outputAvailable[channel];
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        // Add input sample to buffer
+        inputBuf[inPos] = channelData[sample];
+        inPos++;
+
+        // When input buffer is full, process with RubberBand
+        if (inPos >= rbBlockSize)
+        {
+            const float* inPtr = inputBuf.data();
+            float* outPtr = outputBuf.data();
+            shifter->shift(&inPtr, &outPtr);
+
+            // Copy output to FIFO
+            size_t fifoSize = outputFIFO.size();
+            size_t writePos = (outPos + outAvail) % fifoSize;
+            for (size_t i = 0; i < rbBlockSize; ++i)
+            {
+                outputFIFO[(writePos + i) % fifoSize] = outputBuf[i];
+            }
+            outAvail += rbBlockSize;
+
+            inPos = 0;
+        }
+
+        // Read from output FIFO if samples are available.
+        // Until then (initial latency) the input passes through to avoid silence.
+        if (outAvail > 0)
+        {
+            channelData[sample] = outputFIFO[outPos];
+            outPos = (outPos + 1) % outputFIFO.size();
+            outAvail--;
+        }
+    }
+}
+
 //==============================================================================
 // PitchDriftBrain Implementation
 //==============================================================================
@@ -11,50 +107,59 @@ void PitchDriftBrain::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
-    numChannels = 2;  // Prepare for stereo
-
-    // Clear existing shifters
-    shifters.clear();
-    inputBuffers.clear();
-    outputBuffers.clear();
-    outputFIFOs.clear();
-    inputPos.clear();
-    outputPos.clear();
-    outputAvailable.clear();
-
-    // Create one RubberBand shifter per channel
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        shifters.push_back(std::make_unique<RubberBand::RubberBandLiveShifter>(
-            (size_t)sampleRate,
-            1,  // mono per channel
-            RubberBand::RubberBandLiveShifter::OptionWindowShort
-        ));
-    }
+    // The window is fixed until the next prepare() so the latency reported
+    // to the host always matches what the shifters add.
+    const auto options = quality == ProcessingQuality::High ? RubberBand::RubberBandLiveShifter::OptionWindowMedium
+                                                            : RubberBand::RubberBandLiveShifter::OptionWindowShort;
 
-    rbBlockSize = shifters[0]->getBlockSize();
+    // Hosts re-prepare on every transport start and buffer-size change.
+    // Shifters only depend on the sample rate and window, so keep (and reset)
+    // the bank we have unless those changed.
+    const bool rebuild = sampleRate != shifterSampleRate || options != shifterOptions;
+    shifterSampleRate = sampleRate;
+    shifterOptions = options;
 
-    // Allocate buffers for each channel
-    for (int ch = 0; ch < numChannels; ++ch)
+    if (rebuild)
+        shifterLatency = ShifterBank::getLatencySamples(sampleRate, options);
+
+    shifterBank.prepare([sampleRate, options] { return std::make_unique<ShifterBank>(sampleRate, options); },
+                        sampleRate, rebuild, isActive());
+
+    activeChannels = quality == ProcessingQuality::Eco ? 1 : ShifterBank::numChannels;
+}
+
+void PitchDriftBrain::updateHeldPitch()
+{
+    if (analysis == nullptr)
+        return;
+
+    const auto& pitch = analysis->getPitch();
+    pitchConfidence = pitch.confidence;
+
+    // Glide toward confident estimates; hold the last note through
+    // consonants and breaths so behavior modes keep a stable anchor
+    if (pitch.confidence > 0.8f && pitch.frequencyHz > 0.0f)
     {
-        inputBuffers.push_back(std::vector<float>(rbBlockSize, 0.0f));
-        outputBuffers.push_back(std::vector<float>(rbBlockSize, 0.0f));
-        // FIFO needs to hold at least 2 blocks worth of samples
-        outputFIFOs.push_back(std::vector<float>(rbBlockSize * 4, 0.0f));
-        inputPos.push_back(0);
-        outputPos.push_back(0);
-        outputAvailable.push_back(0);
+        if (heldPitchHz <= 0.0f)
+            heldPitchHz = pitch.frequencyHz;
+        else
+            heldPitchHz += (pitch.frequencyHz - heldPitchHz) * 0.3f;
     }
 }
 
-void PitchDriftBrain::process(juce::AudioBuffer<float>& buffer)
+void PitchDriftBrain::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
-    // Skip entirely if no range is set (both at 0)
-    if (!enabled || (centsLow >= 0.0f && centsHigh <= 0.0f) || shifters.empty())
+    if (enabled)
+        updateHeldPitch();
+
+    // Skip entirely if no range is set (both at 0), and pass through until
+    // the housekeeping thread has built the shifters
+    auto* bank = shifterBank.acquire(isActive(), (int)block.getNumSamples());
+    if (!isActive() || bank == nullptr)
         return;
 
-    const int numSamples = buffer.getNumSamples();
-    const int bufferChannels = buffer.getNumChannels();
+    const int numSamples = (int)block.getNumSamples();
+    const int bufferChannels = (int)block.getNumChannels();
 
     // LFO frequency: lfoSpeed 0-1 maps to 0.1 Hz to 5 Hz
     float lfoFreqHz = 0.1f + lfoSpeed * 4.9f;
@@ -82,7 +187,9 @@ void PitchDriftBrain::process(juce::AudioBuffer<float>& buffer)
             if (randomizeMode)
             {
                 // Random mode: pick random target within range
-                targetCents = centsLow + random.nextFloat() * (centsHigh - centsLow);
+                auto& rng = getRandom(0);
+                rng.seekToSample(blockStartSample + (juce::uint64)i);
+                targetCents = centsLow + rng.nextFloat() * (centsHigh - centsLow);
             }
             else
             {
@@ -120,79 +227,48 @@ void PitchDriftBrain::process(juce::AudioBuffer<float>& buffer)
     // Convert cents to pitch scale: scale = 2^(cents/1200)
     double pitchScale = std::pow(2.0, currentCents / 1200.0);
 
+    // Eco: one shifter runs on the mid signal and feeds every side
+    const bool sharedMid = activeChannels == 1 && bufferChannels > 1;
+    if (sharedMid)
+    {
+        const auto mid = block.getSingleChannelBlock(0);
+        for (int channel = 1; channel < bufferChannels; ++channel)
+            mid.add(block.getSingleChannelBlock((size_t)channel));
+        mid.multiplyBy(1.0f / (float)bufferChannels);
+    }
+
     // Process each channel independently
-    for (int channel = 0; channel < bufferChannels && channel < numChannels; ++channel)
+    for (int channel = 0; channel < bufferChannels && channel < activeChannels; ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        auto& shifter = shifters[channel];
-        auto& inputBuf = inputBuffers[channel];
-        auto& outputBuf = outputBuffers[channel];
-        auto& outputFIFO = outputFIFOs[channel];
-        size_t& inPos = inputPos[channel];
-        size_t& outPos = outputPos[channel];
-        size_t& outAvail = outputAvailable[channel];
+        auto* channelData = block.getChannelPointer((size_t)channel);
 
-        shifter->setPitchScale(pitchScale);
+        bank->shifters[channel]->setPitchScale(pitchScale);
+        bank->process(channel, channelData, numSamples);
+    }
 
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Add input sample to buffer
-            inputBuf[inPos] = channelData[sample];
-            inPos++;
+    if (sharedMid)
+    {
+        for (int channel = 1; channel < bufferChannels; ++channel)
+            block.getSingleChannelBlock((size_t)channel).copyFrom(block.getSingleChannelBlock(0));
+    }
+}
 
-            // When input buffer is full, process with RubberBand
-            if (inPos >= rbBlockSize)
-            {
-                const float* inPtr = inputBuf.data();
-                float* outPtr = outputBuf.data();
-                shifter->shift(&inPtr, &outPtr);
-
-                // Copy output to FIFO
-                size_t fifoSize = outputFIFO.size();
-                size_t writePos = (outPos + outAvail) % fifoSize;
-                for (size_t i = 0; i < rbBlockSize; ++i)
-                {
-                    outputFIFO[(writePos + i) % fifoSize] = outputBuf[i];
-                }
-                outAvail += rbBlockSize;
+void PitchDriftBrain::qualityChanged()
+{
+    const int channelsToUse = quality == ProcessingQuality::Eco ? 1 : ShifterBank::numChannels;
 
-                inPos = 0;
-            }
+    // A shifter that sat idle in Eco starts from silence rather than stale audio
+    if (auto* bank = shifterBank.get())
+        for (int ch = activeChannels; ch < channelsToUse; ++ch)
+            bank->resetChannel(ch);
 
-            // Read from output FIFO if samples are available
-            if (outAvail > 0)
-            {
-                channelData[sample] = outputFIFO[outPos];
-                outPos = (outPos + 1) % outputFIFO.size();
-                outAvail--;
-            }
-            // If no output available yet (initial latency), pass through or output silence
-            // We'll pass through the input to avoid silence during startup
-        }
-    }
+    activeChannels = channelsToUse;
 }
 
 void PitchDriftBrain::reset()
 {
-    for (auto& shifter : shifters)
-    {
-        if (shifter)
-            shifter->reset();
-    }
-
-    for (auto& buf : inputBuffers)
-        std::fill(buf.begin(), buf.end(), 0.0f);
-    for (auto& buf : outputBuffers)
-        std::fill(buf.begin(), buf.end(), 0.0f);
-    for (auto& fifo : outputFIFOs)
-        std::fill(fifo.begin(), fifo.end(), 0.0f);
-
-    for (size_t i = 0; i < inputPos.size(); ++i)
-    {
-        inputPos[i] = 0;
-        outputPos[i] = 0;
-        outputAvailable[i] = 0;
-    }
+    if (auto* bank = shifterBank.get())
+        bank->reset();
 
     lfoPhase = 0.0f;
     currentCents = 0.0f;
@@ -200,6 +276,8 @@ void PitchDriftBrain::reset()
     previousCents = 0.0f;
     wasPositive = true;
     wasPeak = false;
+    heldPitchHz = 0.0f;
+    pitchConfidence = 0.0f;
 }
 
 //==============================================================================
@@ -213,50 +291,37 @@ void FormantWhispers::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
-    numChannels = 2;  // Prepare for stereo
-
-    // Clear existing shifters
-    shifters.clear();
-    inputBuffers.clear();
-    outputBuffers.clear();
-    outputFIFOs.clear();
-    inputPos.clear();
-    outputPos.clear();
-    outputAvailable.clear();
-
-    // Create one RubberBand shifter per channel
-    // Using OptionFormantPreserved to allow independent formant control
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        shifters.push_back(std::make_unique<RubberBand::RubberBandLiveShifter>(
-            (size_t)sampleRate,
-            1,  // mono per channel
-            RubberBand::RubberBandLiveShifter::OptionWindowShort
-        ));
-    }
+    // The window is fixed until the next prepare() so the latency reported
+    // to the host always matches what the shifters add.
+    const auto options = quality == ProcessingQuality::High ? RubberBand::RubberBandLiveShifter::OptionWindowMedium
+                                                            : RubberBand::RubberBandLiveShifter::OptionWindowShort;
 
-    rbBlockSize = shifters[0]->getBlockSize();
+    // Hosts re-prepare on every transport start and buffer-size change.
+    // Shifters only depend on the sample rate and window, so keep (and reset)
+    // the bank we have unless those changed.
+    const bool rebuild = sampleRate != shifterSampleRate || options != shifterOptions;
+    shifterSampleRate = sampleRate;
+    shifterOptions = options;
 
-    // Allocate buffers for each channel
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        inputBuffers.push_back(std::vector<float>(rbBlockSize, 0.0f));
-        outputBuffers.push_back(std::vector<float>(rbBlockSize, 0.0f));
-        outputFIFOs.push_back(std::vector<float>(rbBlockSize * 4, 0.0f));
-        inputPos.push_back(0);
-        outputPos.push_back(0);
-        outputAvailable.push_back(0);
-    }
+    if (rebuild)
+        shifterLatency = ShifterBank::getLatencySamples(sampleRate, options);
+
+    shifterBank.prepare([sampleRate, options] { return std::make_unique<ShifterBank>(sampleRate, options); },
+                        sampleRate, rebuild, isActive());
+
+    activeChannels = quality == ProcessingQuality::Eco ? 1 : ShifterBank::numChannels;
 }
 
-void FormantWhispers::process(juce::AudioBuffer<float>& buffer)
+void FormantWhispers::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
-    // Skip if no range is set or not enabled
-    if (!enabled || (formantShiftLow >= 0.0f && formantShiftHigh <= 0.0f) || shifters.empty())
+    // Skip if no range is set or not enabled, and pass through until the
+    // housekeeping thread has built the shifters
+    auto* bank = shifterBank.acquire(isActive(), (int)block.getNumSamples());
+    if (!isActive() || bank == nullptr)
         return;
 
-    const int numSamples = buffer.getNumSamples();
-    const int bufferChannels = buffer.getNumChannels();
+    const int numSamples = (int)block.getNumSamples();
+    const int bufferChannels = (int)block.getNumChannels();
 
     // LFO frequency: formantLFOSpeed 0-1 maps to 0.1 Hz to 5 Hz
     float lfoFreqHz = 0.1f + formantLFOSpeed * 4.9f;
@@ -280,7 +345,9 @@ void FormantWhispers::process(juce::AudioBuffer<float>& buffer)
 
             if (formantRandomizeMode)
             {
-                targetFormantShift = formantShiftLow + random.nextFloat() * (formantShiftHigh - formantShiftLow);
+                auto& rng = getRandom(0);
+                rng.seekToSample(blockStartSample + (juce::uint64)i);
+                targetFormantShift = formantShiftLow + rng.nextFloat() * (formantShiftHigh - formantShiftLow);
             }
             else
             {
@@ -308,79 +375,50 @@ void FormantWhispers::process(juce::AudioBuffer<float>& buffer)
     // Map -1..+1 to 0.5..2.0
     double formantScale = std::pow(2.0, currentFormantShift);
 
+    // Eco: one shifter runs on the mid signal and feeds every side
+    const bool sharedMid = activeChannels == 1 && bufferChannels > 1;
+    if (sharedMid)
+    {
+        const auto mid = block.getSingleChannelBlock(0);
+        for (int channel = 1; channel < bufferChannels; ++channel)
+            mid.add(block.getSingleChannelBlock((size_t)channel));
+        mid.multiplyBy(1.0f / (float)bufferChannels);
+    }
+
     // Process each channel independently
-    for (int channel = 0; channel < bufferChannels && channel < numChannels; ++channel)
+    for (int channel = 0; channel < bufferChannels && channel < activeChannels; ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        auto& shifter = shifters[channel];
-        auto& inputBuf = inputBuffers[channel];
-        auto& outputBuf = outputBuffers[channel];
-        auto& outputFIFO = outputFIFOs[channel];
-        size_t& inPos = inputPos[channel];
-        size_t& outPos = outputPos[channel];
-        size_t& outAvail = outputAvailable[channel];
+        auto* channelData = block.getChannelPointer((size_t)channel);
 
         // Set pitch to 1.0 (no pitch change) but shift formants
-        shifter->setPitchScale(1.0);
-        shifter->setFormantScale(formantScale);
+        bank->shifters[channel]->setPitchScale(1.0);
+        bank->shifters[channel]->setFormantScale(formantScale);
+        bank->process(channel, channelData, numSamples);
+    }
 
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Add input sample to buffer
-            inputBuf[inPos] = channelData[sample];
-            inPos++;
+    if (sharedMid)
+    {
+        for (int channel = 1; channel < bufferChannels; ++channel)
+            block.getSingleChannelBlock((size_t)channel).copyFrom(block.getSingleChannelBlock(0));
+    }
+}
 
-            // When input buffer is full, process with RubberBand
-            if (inPos >= rbBlockSize)
-            {
-                const float* inPtr = inputBuf.data();
-                float* outPtr = outputBuf.data();
-                shifter->shift(&inPtr, &outPtr);
-
-                // Copy output to FIFO
-                size_t fifoSize = outputFIFO.size();
-                size_t writePos = (outPos + outAvail) % fifoSize;
-                for (size_t i = 0; i < rbBlockSize; ++i)
-                {
-                    outputFIFO[(writePos + i) % fifoSize] = outputBuf[i];
-                }
-                outAvail += rbBlockSize;
+void FormantWhispers::qualityChanged()
+{
+    const int channelsToUse = quality == ProcessingQuality::Eco ? 1 : ShifterBank::numChannels;
 
-                inPos = 0;
-            }
+    // A shifter that sat idle in Eco starts from silence rather than stale audio
+    if (auto* bank = shifterBank.get())
+        for (int ch = activeChannels; ch < channelsToUse; ++ch)
+            bank->resetChannel(ch);
 
-            // Read from output FIFO if samples are available
-            if (outAvail > 0)
-            {
-                channelData[sample] = outputFIFO[outPos];
-                outPos = (outPos + 1) % outputFIFO.size();
-                outAvail--;
-            }
-        }
-    }
+    activeChannels = channelsToUse;
 }
 
 void FormantWhispers::reset()
 {
-    for (auto& shifter : shifters)
-    {
-        if (shifter)
-            shifter->reset();
-    }
-
-    for (auto& buf : inputBuffers)
-        std::fill(buf.begin(), buf.end(), 0.0f);
-    for (auto& buf : outputBuffers)
-        std::fill(buf.begin(), buf.end(), 0.0f);
-    for (auto& fifo : outputFIFOs)
-        std::fill(fifo.begin(), fifo.end(), 0.0f);
-
-    for (size_t i = 0; i < inputPos.size(); ++i)
-    {
-        inputPos[i] = 0;
-        outputPos[i] = 0;
-        outputAvailable[i] = 0;
-    }
+    if (auto* bank = shifterBank.get())
+        bank->reset();
 
     formantLFOPhase = 0.0f;
     formantWasPositive = true;
@@ -406,29 +444,28 @@ void BreathNoiseEngine::prepare(double sampleRate, int samplesPerBlock)
     breathFilter.reset();
 }
 
-void BreathNoiseEngine::process(juce::AudioBuffer<float>& buffer)
+void BreathNoiseEngine::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
-    if (!enabled || mix <= 0.0f || breathIntensity <= 0.0f)
+    if (!enabled || mix <= 0.0f || breathIntensity <= 0.0f || analysis == nullptr)
         return;
 
-    const int numSamples = buffer.getNumSamples();
+    const auto& envelopes = analysis->getEnvelopes();
+    const int numSamples = juce::jmin((int)block.getNumSamples(), envelopes.getNumSamples());
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    for (int channel = 0; channel < (int)block.getNumChannels(); ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
+        auto* channelData = block.getChannelPointer((size_t)channel);
+        const float* envelope = envelopes.getRms(channel);
+        auto& rng = getRandom(channel);
 
         for (int sample = 0; sample < numSamples; ++sample)
         {
-            // Envelope follower
-            float input = channelData[sample];
-            float env = std::abs(input);
-            envelopeFollower = envelopeFollower * 0.999f + env * 0.001f;
-
-            // Generate breath noise based on envelope
-            if (envelopeFollower > 0.01f)
+            // Generate breath noise based on this channel's shared RMS envelope
+            if (envelope[sample] > 0.01f)
             {
-                float noise = (random.nextFloat() * 2.0f - 1.0f) * breathIntensity * 0.1f;
-                channelData[sample] += noise * envelopeFollower;
+                rng.seekToSample(blockStartSample + (juce::uint64)sample);
+                float noise = (rng.nextFloat() * 2.0f - 1.0f) * breathIntensity * 0.1f;
+                channelData[sample] += noise * envelope[sample];
             }
         }
     }
@@ -437,7 +474,6 @@ void BreathNoiseEngine::process(juce::AudioBuffer<float>& buffer)
 void BreathNoiseEngine::reset()
 {
     breathFilter.reset();
-    envelopeFollower = 0.0f;
 }
 
 //==============================================================================
@@ -451,49 +487,68 @@ void TimingWobble::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
-    timingBuffer.prepare({sampleRate, (juce::uint32)samplesPerBlock, 1});
-    timingBuffer.reset();
+
+    timingBuffer.prepare([sampleRate, samplesPerBlock]
+                         {
+                             auto line = std::make_unique<juce::dsp::DelayLine<float>>(44100);
+                             line->prepare({sampleRate, (juce::uint32)samplesPerBlock, 1});
+                             return line;
+                         },
+                         sampleRate, true, isActive());
 }
 
-void TimingWobble::process(juce::AudioBuffer<float>& buffer)
+void TimingWobble::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
-    if (!enabled || wobbleAmount <= 0.0f)
+    auto* line = timingBuffer.acquire(isActive(), (int)block.getNumSamples());
+    if (!isActive() || line == nullptr)
         return;
 
-    const int numSamples = buffer.getNumSamples();
+    const int numSamples = (int)block.getNumSamples();
 
     // Maximum wobble in samples (at 44.1kHz: ~10ms max delay)
     float maxWobbleSamples = (float)currentSampleRate * 0.01f * wobbleAmount;
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    const auto& onsets = getOnsets();
+
+    for (int channel = 0; channel < (int)block.getNumChannels(); ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
+        auto* channelData = block.getChannelPointer((size_t)channel);
+        auto& rng = getRandom(channel);
+        int nextOnset = 0;
 
         for (int sample = 0; sample < numSamples; ++sample)
         {
             float input = channelData[sample];
 
-            // Detect transients (simple envelope follower)
-            float env = std::abs(input);
+            // Syllable onsets from the shared detector
+            float onsetStrength = 0.0f;
+            if (nextOnset < onsets.size() && onsets[nextOnset].sampleOffset == sample)
+                onsetStrength = onsets[nextOnset++].strength;
 
-            // Slowly modulate target delay with swing feel
-            if (sample % 256 == 0)
+            // Slowly modulate target delay with swing feel; every onset
+            // re-rolls the push/pull and leans harder on the late side
+            if ((blockStartSample + (juce::uint64)sample) % 256 == 0 || onsetStrength > 0.0f)
             {
                 // Random micro-timing drift
-                float wobble = (random.nextFloat() - 0.5f) * 2.0f * maxWobbleSamples;
+                rng.seekToSample(blockStartSample + (juce::uint64)sample);
+                float wobble = (rng.nextFloat() - 0.5f) * 2.0f * maxWobbleSamples;
 
                 // Add swing feel (slight delay on even beats)
                 float swing = swingFeel * maxWobbleSamples * 0.5f;
 
-                float targetDelay = juce::jmax(0.0f, wobble + swing);
-                currentDelay = currentDelay * 0.95f + targetDelay * 0.05f;
+                // "Late on purpose" on stressed syllables
+                float lateness = onsetStrength * maxWobbleSamples * 0.5f;
+
+                float targetDelay = juce::jmax(0.0f, wobble + swing + lateness);
+                float smoothing = onsetStrength > 0.0f ? 0.3f : 0.05f;
+                currentDelay = currentDelay * (1.0f - smoothing) + targetDelay * smoothing;
             }
 
             // Push to delay line
-            timingBuffer.pushSample(0, input);
+            line->pushSample(0, input);
 
             // Pop with variable delay
-            float delayedSample = timingBuffer.popSample(0, currentDelay);
+            float delayedSample = line->popSample(0, currentDelay);
 
             // Mix
             channelData[sample] = input * (1.0f - mix) + delayedSample * mix;
@@ -503,7 +558,8 @@ void TimingWobble::process(juce::AudioBuffer<float>& buffer)
 
 void TimingWobble::reset()
 {
-    timingBuffer.reset();
+    if (auto* line = timingBuffer.get())
+        line->reset();
     currentDelay = 0.0f;
 }
 
@@ -520,31 +576,33 @@ void VolumePersonality::prepare(double sampleRate, int samplesPerBlock)
     currentBlockSize = samplesPerBlock;
 }
 
-void VolumePersonality::process(juce::AudioBuffer<float>& buffer)
+void VolumePersonality::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
     if (!enabled || intensity <= 0.0f)
         return;
 
     // Simple volume wobble based on personality
-    const int numSamples = buffer.getNumSamples();
+    const int numSamples = (int)block.getNumSamples();
 
     for (int sample = 0; sample < numSamples; ++sample)
     {
         // Slowly move toward target gain
         currentGain = currentGain * 0.999f + targetGain * 0.001f;
 
-        // Randomly adjust target every N samples
-        if (sample % 512 == 0)
+        // Randomly adjust target every N samples of the render timeline
+        if ((blockStartSample + (juce::uint64)sample) % 512 == 0)
         {
-            float wobble = (random.nextFloat() * 2.0f - 1.0f) * intensity * 0.1f;
+            auto& rng = getRandom(0);
+            rng.seekToSample(blockStartSample + (juce::uint64)sample);
+            float wobble = (rng.nextFloat() * 2.0f - 1.0f) * intensity * 0.1f;
             targetGain = 1.0f + wobble;
         }
 
         // Apply gain
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        for (int channel = 0; channel < (int)block.getNumChannels(); ++channel)
         {
-            buffer.setSample(channel, sample,
-                           buffer.getSample(channel, sample) * currentGain);
+            block.setSample(channel, sample,
+                           block.getSample(channel, sample) * currentGain);
         }
     }
 }
@@ -555,6 +613,159 @@ void VolumePersonality::reset()
     targetGain = 1.0f;
 }
 
+//==============================================================================
+// FeedbackDelayNetwork Implementation
+//==============================================================================
+void FeedbackDelayNetwork::prepare(double sampleRate, int controlIntervalToUse)
+{
+    currentSampleRate = sampleRate;
+    controlInterval = controlIntervalToUse;
+
+    // Mutually prime-ish lengths for a tiled room a couple of metres across
+    const float delayMs[numLines] = { 11.3f, 13.7f, 16.1f, 18.7f, 21.1f, 23.9f, 27.7f, 31.3f };
+    const float rateHz[numLines] = { 0.31f, 0.43f, 0.57f, 0.61f, 0.73f, 0.83f, 0.97f, 1.09f };
+
+    modulationDepth = 0.00015f * (float)sampleRate;
+
+    float longest = 0.0f;
+    for (int i = 0; i < numLines; ++i)
+    {
+        baseDelay[i] = delayMs[i] * 0.001f * (float)sampleRate;
+        modulationIncrement[i] = juce::MathConstants<float>::twoPi * rateHz[i] / (float)sampleRate;
+        longest = juce::jmax(longest, baseDelay[i]);
+    }
+
+    lineSize = juce::nextPowerOfTwo((int)std::ceil(longest + modulationDepth) + 4);
+    lineMask = lineSize - 1;
+    lines.assign((size_t)(numLines * lineSize), 0.0f);
+
+    // Sylvester Hadamard: the sign is the parity of the shared index bits
+    const float matrixScale = 1.0f / std::sqrt((float)numLines);
+    for (int column = 0; column < lanes; ++column)
+        for (int row = 0; row < lanes; ++row)
+            hadamardColumns[column][row] = (((column & row) ^ ((column & row) >> 1)) & 1) != 0 ? -matrixScale : matrixScale;
+
+    gainsForDecay = -1.0f;
+    dampingForHumidity = -1.0f;
+    reset();
+}
+
+void FeedbackDelayNetwork::reset()
+{
+    std::fill(lines.begin(), lines.end(), 0.0f);
+    writePosition = 0;
+    samplesToControl = 0;
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        dampState[i] = 0.0f;
+        modulationPhase[i] = 0.7f * (float)i;
+        tapDelay[i] = baseDelay[i];
+        delayStep[i] = 0.0f;
+    }
+}
+
+void FeedbackDelayNetwork::updateControl()
+{
+    // Per-line gain for a -60 dB decay over decaySeconds
+    if (decaySeconds != gainsForDecay)
+    {
+        gainsForDecay = decaySeconds;
+        for (int i = 0; i < numLines; ++i)
+            feedbackGain[i] = std::pow(10.0f, -3.0f * baseDelay[i] / (decaySeconds * (float)currentSampleRate));
+    }
+
+    // Steam soaks up the top end: 12 kHz dry room down to 2.5 kHz in a fog
+    if (humidity != dampingForHumidity)
+    {
+        dampingForHumidity = humidity;
+        const float cutoffHz = juce::jmin(12000.0f * std::pow(2500.0f / 12000.0f, humidity), 0.45f * (float)currentSampleRate);
+        dampCoeff = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * cutoffHz / (float)currentSampleRate);
+    }
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        modulationPhase[i] += modulationIncrement[i] * (float)controlInterval;
+        if (modulationPhase[i] > juce::MathConstants<float>::twoPi)
+            modulationPhase[i] -= juce::MathConstants<float>::twoPi;
+
+        const float target = baseDelay[i] + modulationDepth * std::sin(modulationPhase[i]);
+        delayStep[i] = (target - tapDelay[i]) / (float)controlInterval;
+    }
+}
+
+void FeedbackDelayNetwork::process(const float* inputLeft, const float* inputRight, float* outputLeft, float* outputRight, int numSamples)
+{
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        if (samplesToControl == 0)
+        {
+            updateControl();
+            samplesToControl = controlInterval;
+        }
+        --samplesToControl;
+
+        alignas(32) float out[numLines];
+        alignas(32) float mixed[numLines];
+        alignas(32) float feedback[numLines];
+
+        // Modulated, interpolated read from every line
+        for (int i = 0; i < numLines; ++i)
+        {
+            const float* line = lines.data() + i * lineSize;
+            const float readPosition = (float)writePosition - tapDelay[i];
+            const int index = (int)std::floor(readPosition);
+            const float frac = readPosition - (float)index;
+            const float a = line[index & lineMask];
+            out[i] = a + frac * (line[(index + 1) & lineMask] - a);
+            tapDelay[i] += delayStep[i];
+        }
+
+        // Damping and feedback gain, lines 0-3 and 4-7 a register each
+        const auto damping = Lanes::expand(dampCoeff);
+        auto dampLow = Lanes::fromRawArray(dampState);
+        auto dampHigh = Lanes::fromRawArray(dampState + lanes);
+        dampLow = dampLow + damping * (Lanes::fromRawArray(out) - dampLow);
+        dampHigh = dampHigh + damping * (Lanes::fromRawArray(out + lanes) - dampHigh);
+        dampLow.copyToRawArray(dampState);
+        dampHigh.copyToRawArray(dampState + lanes);
+
+        const auto feedbackLow = dampLow * Lanes::fromRawArray(feedbackGain);
+        const auto feedbackHigh = dampHigh * Lanes::fromRawArray(feedbackGain + lanes);
+
+        // Hadamard mix: the span-4 butterfly across the registers...
+        (feedbackLow + feedbackHigh).copyToRawArray(mixed);
+        (feedbackLow - feedbackHigh).copyToRawArray(mixed + lanes);
+
+        // ...then spans 1 and 2 as a 4x4 Hadamard within each register
+        auto mixLow = Lanes::expand(0.0f);
+        auto mixHigh = Lanes::expand(0.0f);
+        for (int i = 0; i < lanes; ++i)
+        {
+            const auto column = Lanes::fromRawArray(hadamardColumns[i]);
+            mixLow = mixLow + Lanes::expand(mixed[i]) * column;
+            mixHigh = mixHigh + Lanes::expand(mixed[lanes + i]) * column;
+        }
+
+        // Left feeds the even lines, right the odd ones
+        const float left = inputLeft[sample];
+        const float right = inputRight[sample];
+        alignas(16) const float stereoInput[lanes] = { left, right, left, right };
+        const auto input = Lanes::fromRawArray(stereoInput);
+
+        (mixLow + input).copyToRawArray(feedback);
+        (mixHigh + input).copyToRawArray(feedback + lanes);
+
+        for (int i = 0; i < numLines; ++i)
+            lines[(size_t)(i * lineSize + writePosition)] = feedback[i];
+
+        outputLeft[sample] = 0.5f * (out[0] + out[2] + out[4] + out[6]);
+        outputRight[sample] = 0.5f * (out[1] + out[3] + out[5] + out[7]);
+
+        writePosition = (writePosition + 1) & lineMask;
+    }
+}
+
 //==============================================================================
 // PorcelainReflections Implementation
 //==============================================================================
@@ -567,63 +778,136 @@ void PorcelainReflections::prepare(double sampleRate, int samplesPerBlock)
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
 
-    juce::dsp::ProcessSpec spec{sampleRate, (juce::uint32)samplesPerBlock, 1};
+    // One stereo line per surface, long enough for the furthest tap plus full scatter
+    juce::dsp::ProcessSpec spec{sampleRate, (juce::uint32)samplesPerBlock, 2};
     for (int i = 0; i < NUM_REFLECTIONS; ++i)
     {
         reflections[i].prepare(spec);
+        reflections[i].setMaximumDelayInSamples((int)std::ceil(sampleRate * maxReflectionMs / 1000.0));
         reflections[i].reset();
-
-        // Set different delay times for each reflection (early reflections pattern)
-        float delayMs = 5.0f + (i * 7.3f); // Irregular spacing
-        reflections[i].setMaximumDelayInSamples((int)(sampleRate * delayMs / 1000.0));
     }
+
+    tapWet.setSize(2, samplesPerBlock);
+    lateWet.setSize(2, samplesPerBlock);
+    lateReverb.prepare(sampleRate, getControlInterval());
+    qualityChanged();
+
+    convolution.prepare(sampleRate, samplesPerBlock);
+    convolutionWet.setSize(2, samplesPerBlock);
+}
+
+void PorcelainReflections::qualityChanged()
+{
+    // Eco reads the earliest, loudest taps; High adds the second-order bounces
+    numActiveReflections = quality == ProcessingQuality::Eco    ? standardReflections / 2
+                         : quality == ProcessingQuality::High   ? NUM_REFLECTIONS
+                                                                : standardReflections;
+    lateReverb.setControlInterval(getControlInterval());
+}
+
+void PorcelainReflections::processConvolution(const juce::dsp::AudioBlock<float>& block)
+{
+    const int numChannels = juce::jmin((int)block.getNumChannels(), convolutionWet.getNumChannels());
+    const int numSamples = juce::jmin((int)block.getNumSamples(), convolutionWet.getNumSamples());
+
+    convolution.process(block, convolutionWet, numSamples);
+
+    // Same blend as the tap model: the tub is added on top of the voice
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::addWithMultiply(block.getChannelPointer((size_t)channel), convolutionWet.getReadPointer(channel),
+                                                     tileScatter * mix, numSamples);
 }
 
-void PorcelainReflections::process(juce::AudioBuffer<float>& buffer)
+void PorcelainReflections::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
-    if (!enabled || tileScatter <= 0.0f)
+    if (!enabled || (tileScatter <= 0.0f && lateLevel <= 0.0f))
+        return;
+
+    if (convolutionMode && convolution.hasImpulseResponse())
+    {
+        if (tileScatter > 0.0f)
+            processConvolution(block);
         return;
+    }
 
-    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin((int)block.getNumChannels(), tapWet.getNumChannels());
+    const int numSamples = juce::jmin((int)block.getNumSamples(), tapWet.getNumSamples());
 
-    // Delay times in samples for different "surfaces" (tile, mirror, sink, etc.)
-    const float delayTimesMs[NUM_REFLECTIONS] = {5.3f, 8.7f, 12.1f, 17.4f, 23.8f, 31.2f, 42.5f, 56.7f};
-    const float gains[NUM_REFLECTIONS] = {0.3f, 0.25f, 0.2f, 0.18f, 0.15f, 0.12f, 0.1f, 0.08f};
+    // Delay times in samples for different "surfaces" (tile, mirror, sink, etc.),
+    // then the fainter second-order bounces between them that only High reads
+    const float delayTimesMs[NUM_REFLECTIONS] = {5.3f, 8.7f, 12.1f, 17.4f, 23.8f, 31.2f, 42.5f, 56.7f,
+                                                 7.1f, 14.6f, 27.3f, 48.9f};
+    const float gains[NUM_REFLECTIONS] = {0.3f, 0.25f, 0.2f, 0.18f, 0.15f, 0.12f, 0.1f, 0.08f,
+                                          0.09f, 0.07f, 0.06f, 0.05f};
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    // Early reflections: always run, they are what the late tail is fed from
+    for (int channel = 0; channel < numChannels; ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
+        const auto* channelData = block.getChannelPointer((size_t)channel);
+        auto* wetData = tapWet.getWritePointer(channel);
+
+        auto& rng = getRandom(channel);
 
         for (int sample = 0; sample < numSamples; ++sample)
         {
             float input = channelData[sample];
             float wetSignal = 0.0f;
+            rng.seekToSample(blockStartSample + (juce::uint64)sample);
 
-            // Sum all reflections
+            // Keep every line current, whatever this tier reads
             for (int r = 0; r < NUM_REFLECTIONS; ++r)
+                reflections[r].pushSample(channel, input);
+
+            // Sum the active reflections
+            for (int r = 0; r < numActiveReflections; ++r)
             {
                 // Add slight random modulation to delay time (simulates moving head/room chaos)
-                float modulatedDelay = delayTimesMs[r] + (random.nextFloat() - 0.5f) * tileScatter * 2.0f;
+                float modulatedDelay = delayTimesMs[r] + (rng.nextFloat() - 0.5f) * tileScatter * 2.0f;
                 float delaySamples = (modulatedDelay / 1000.0f) * (float)currentSampleRate;
 
-                reflections[r].pushSample(0, input);
-                float delayed = reflections[r].popSample(0, delaySamples);
+                float delayed = reflections[r].popSample(channel, delaySamples);
 
                 // Apply gain with edge slap resonance
                 float resonance = 1.0f + edgeSlap * 0.5f * std::sin((float)r * 0.8f);
                 wetSignal += delayed * gains[r] * resonance;
             }
 
-            // Mix wet with dry
-            channelData[sample] = input * (1.0f - mix) + (input + wetSignal * tileScatter) * mix;
+            wetData[sample] = wetSignal;
+        }
+    }
+
+    // Late tail: the reflections diffuse into the FDN (mono feeds both sides)
+    if (lateLevel > 0.0f)
+    {
+        const float* tapRight = tapWet.getReadPointer(numChannels > 1 ? 1 : 0);
+        lateReverb.process(tapWet.getReadPointer(0), tapRight,
+                           lateWet.getWritePointer(0), lateWet.getWritePointer(1), numSamples);
+
+        if (numChannels == 1)
+        {
+            lateWet.applyGain(0, 0, numSamples, 0.5f);
+            lateWet.addFrom(0, 0, lateWet, 1, 0, numSamples, 0.5f);
         }
     }
+
+    // Mix wet on top of the dry voice
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* channelData = block.getChannelPointer((size_t)channel);
+        juce::FloatVectorOperations::addWithMultiply(channelData, tapWet.getReadPointer(channel), tileScatter * mix, numSamples);
+
+        if (lateLevel > 0.0f)
+            juce::FloatVectorOperations::addWithMultiply(channelData, lateWet.getReadPointer(channel), lateLevel * mix, numSamples);
+    }
 }
 
 void PorcelainReflections::reset()
 {
     for (int i = 0; i < NUM_REFLECTIONS; ++i)
         reflections[i].reset();
+
+    lateReverb.reset();
+    convolution.reset();
 }
 
 //==============================================================================
@@ -637,28 +921,29 @@ void SteamModulator::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
+    // Start with biquad-sized coefficients so process() never grows the array
+    *highFreqDamper.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(sampleRate, 20000.0f, 0.707f);
     highFreqDamper.prepare({sampleRate, (juce::uint32)samplesPerBlock, 1});
     highFreqDamper.reset();
 }
 
-void SteamModulator::process(juce::AudioBuffer<float>& buffer)
+void SteamModulator::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
     if (!enabled || humidity <= 0.0f)
         return;
 
-    const int numSamples = buffer.getNumSamples();
+    const int numSamples = (int)block.getNumSamples();
 
     // Calculate lowpass cutoff based on humidity (more humidity = more HF damping)
     float cutoffHz = 20000.0f - (humidity * 15000.0f); // 20kHz down to 5kHz
     cutoffHz = juce::jmax(500.0f, cutoffHz);
 
-    // Update filter coefficients
-    auto coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(currentSampleRate, cutoffHz, 0.707f);
-    *highFreqDamper.coefficients = *coefficients;
+    // Update filter coefficients in place (ArrayCoefficients doesn't touch the heap)
+    *highFreqDamper.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(currentSampleRate, cutoffHz, 0.707f);
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    for (int channel = 0; channel < (int)block.getNumChannels(); ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
+        auto* channelData = block.getChannelPointer((size_t)channel);
 
         for (int sample = 0; sample < numSamples; ++sample)
         {
@@ -675,7 +960,9 @@ void SteamModulator::process(juce::AudioBuffer<float>& buffer)
             float fogNoise = 0.0f;
             if (fogMode && steamIntensity > 0.3f)
             {
-                fogNoise = (random.nextFloat() * 2.0f - 1.0f) * 0.01f * steamIntensity;
+                auto& rng = getRandom(channel);
+                rng.seekToSample(blockStartSample + (juce::uint64)sample);
+                fogNoise = (rng.nextFloat() * 2.0f - 1.0f) * 0.01f * steamIntensity;
             }
 
             // Mix: more humidity = more filtered signal
@@ -692,98 +979,493 @@ void SteamModulator::reset()
 }
 
 //==============================================================================
-// RubberDuckFM Implementation
+// FaucetFlutter Implementation
 //==============================================================================
-RubberDuckFM::RubberDuckFM()
+FaucetFlutter::FaucetFlutter()
 {
 }
 
-void RubberDuckFM::prepare(double sampleRate, int samplesPerBlock)
+void FaucetFlutter::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
+    qualityChanged();
+
+    // Ring covers the deepest flick and the lowest comb tuning (1.5 kHz)
+    maxFlickSamples = (float)(0.004 * sampleRate);
+    const int longestDelay = juce::jmax((int)std::ceil(maxFlickSamples), (int)std::ceil(sampleRate / 1500.0)) + 2;
+    ringSize = juce::nextPowerOfTwo(longestDelay + maxControlInterval);
+    ringMask = ringSize - 1;
+
+    inputRing.assign((size_t)(maxChannels * ringSize), 0.0f);
+    combRing.assign((size_t)(maxChannels * ringSize), 0.0f);
+
+    reset();
 }
 
-void RubberDuckFM::process(juce::AudioBuffer<float>& buffer)
+void FaucetFlutter::triggerDrip(float strength, SeededRandom& rng)
 {
-    if (!enabled || quackIntensity <= 0.0f)
-        return;
+    // 40-90 ms flick; each drip also re-pitches the cold-water ping
+    const float durationSamples = (0.04f + 0.05f * rng.nextFloat()) * (float)currentSampleRate;
+    flickPosition = 0.0f;
+    flickIncrement = (float)controlInterval / durationSamples;
+    flickDepthSamples = maxFlickSamples * dripAmount * strength * (0.5f + 0.5f * rng.nextFloat());
 
-    // Quack mode: formant-following FM synthesis
-    const int numSamples = buffer.getNumSamples();
+    combDelay = juce::roundToInt(currentSampleRate / (1500.0 + 1500.0 * rng.nextFloat()));
+}
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        auto* channelData = buffer.getWritePointer(channel);
+void FaucetFlutter::updateControl(juce::uint64 position)
+{
+    auto& rng = getRandom(0);
+    rng.seekToSample(position);
 
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Simple FM wobble
-            float modulator = std::sin(fmPhase) * quackIntensity;
-            fmPhase += (800.0f / (float)currentSampleRate) * juce::MathConstants<float>::twoPi;
+    const float controlPeriod = (float)controlInterval / (float)currentSampleRate;
 
-            if (fmPhase > juce::MathConstants<float>::twoPi)
-                fmPhase -= juce::MathConstants<float>::twoPi;
+    // Hydro-LFO: rate and waveshape wander; more pressure = faster, choppier flow
+    const float baseRate = 3.0f + 9.0f * waterPressure;
+    hydroRate += 0.05f * (baseRate - hydroRate) + (rng.nextFloat() - 0.5f) * 1.5f;
+    hydroRate = juce::jlimit(1.0f, 20.0f, hydroRate);
+    hydroShape = juce::jlimit(0.5f, 4.0f, hydroShape + (rng.nextFloat() - 0.5f) * 0.3f);
 
-            // Mix original with FM-modulated version
-            float original = channelData[sample];
-            float modulated = original * (1.0f + modulator * 0.3f);
-            channelData[sample] = original * (1.0f - mix) + modulated * mix;
-        }
-    }
-}
+    hydroPhase += juce::MathConstants<float>::twoPi * hydroRate * controlPeriod;
+    if (hydroPhase > juce::MathConstants<float>::twoPi)
+        hydroPhase -= juce::MathConstants<float>::twoPi;
 
-void RubberDuckFM::reset()
-{
-    fmPhase = 0.0f;
-}
+    const float hydro = std::tanh(hydroShape * std::sin(hydroPhase)) / std::tanh(hydroShape);
 
-//==============================================================================
-// SoapBarGlitch Implementation
-//==============================================================================
-SoapBarGlitch::SoapBarGlitch()
-{
-}
+    // Fast random tremolo: pressure surges on top of the flow
+    const float surge = rng.nextFloat() * 2.0f - 1.0f;
+    const float modulation = 0.5f + 0.5f * (0.75f * hydro + 0.25f * surge);
+    tremoloGain = 1.0f - 0.6f * waterPressure * modulation * mix;
 
-void SoapBarGlitch::prepare(double sampleRate, int samplesPerBlock)
-{
-    currentSampleRate = sampleRate;
-    currentBlockSize = samplesPerBlock;
-    grainBuffer.prepare({sampleRate, (juce::uint32)samplesPerBlock, 1});
-    grainBuffer.reset();
+    // The odd drip with nobody singing (~1.5 per second at full pressure)
+    if (flickPosition >= 1.0f && rng.nextFloat() < 1.5f * dripAmount * waterPressure * controlPeriod)
+        triggerDrip(0.5f + 0.5f * rng.nextFloat(), rng);
+
+    if (flickPosition < 1.0f)
+    {
+        flickPosition = juce::jmin(1.0f, flickPosition + flickIncrement);
+        const float shape = std::sin(juce::MathConstants<float>::pi * flickPosition);
+        flickDelay = flickDepthSamples * shape * shape;
+    }
+    else
+    {
+        flickDelay = 0.0f;
+    }
+
+    combFeedback = coldWater * 0.8f;
 }
 
-void SoapBarGlitch::process(juce::AudioBuffer<float>& buffer)
+void FaucetFlutter::processBlock(const juce::dsp::AudioBlock<float>& block)
 {
-    if (!enabled || slipperiness <= 0.0f)
+    if (!enabled || waterPressure <= 0.0f)
         return;
 
-    const int numSamples = buffer.getNumSamples();
+    const int numSamples = (int)block.getNumSamples();
+    const int numChannels = juce::jmin((int)block.getNumChannels(), maxChannels);
 
-    // Grain parameters
-    static float grainPhase = 0.0f;
-    static float slipAmount = 0.0f;
-    static float targetSlip = 0.0f;
-    static int grainSize = 512;
-    static int grainCounter = 0;
+    // Drips come from noisy bursts: onsets landing while the spectrum is hissy
+    const auto& onsets = getOnsets();
+    const bool noisy = analysis != nullptr
+                    && (analysis->getSpectralFrame().flatness > 0.25f
+                        || analysis->getSpectralFrame().bandEnergy[SpectralFrame::High] > 0.3f);
+    int nextOnset = 0;
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    for (int start = 0; start < numSamples; start += controlInterval)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            float input = channelData[sample];
+        const int length = juce::jmin(controlInterval, numSamples - start);
+        const float startGain = tremoloGain;
+        const float startDelay = flickDelay;
 
-            // Push to grain buffer
-            grainBuffer.pushSample(0, input);
+        updateControl(blockStartSample + (juce::uint64)start);
+
+        for (; nextOnset < onsets.size() && onsets[nextOnset].sampleOffset < start + length; ++nextOnset)
+        {
+            if (noisy && dripAmount > 0.0f)
+            {
+                auto& rng = getRandom(1);
+                rng.seekToSample(blockStartSample + (juce::uint64)onsets[nextOnset].sampleOffset);
+                triggerDrip(onsets[nextOnset].strength, rng);
+            }
+        }
+
+        const float endDelay = flickDelay;
+        const float delayStep = (endDelay - startDelay) / (float)length;
+        const bool flicking = startDelay > 0.0f || endDelay > 0.0f;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* channelData = block.getChannelPointer((size_t)channel) + start;
+            float* input = inputRing.data() + channel * ringSize;
+            float* comb = combRing.data() + channel * ringSize;
+            float damping = combDamping[channel];
+
+            for (int sample = 0; sample < length; ++sample)
+            {
+                const int write = (writePosition + sample) & ringMask;
+                const float dry = channelData[sample];
+                input[write] = dry;
+
+                // Drip flick: fractional read tap sliding back and forth
+                float tap = dry;
+                if (flicking)
+                {
+                    const float readPosition = (float)(writePosition + sample) - (startDelay + delayStep * (float)sample);
+                    const int index = (int)std::floor(readPosition);
+                    const float frac = readPosition - (float)index;
+                    const float a = input[index & ringMask];
+                    tap = a + frac * (input[(index + 1) & ringMask] - a);
+                }
+
+                // Cold-water comb with damped feedback
+                damping += 0.35f * (comb[(write - combDelay) & ringMask] - damping);
+                const float resonant = tap + combFeedback * damping;
+                comb[write] = resonant;
+
+                const float wet = tap + 0.5f * (resonant - tap);
+                channelData[sample] = dry + (wet - dry) * mix;
+            }
+
+            combDamping[channel] = damping;
+
+            // Tremolo as one ramp per control block
+            const float gainStep = (tremoloGain - startGain) / (float)length;
+            for (int sample = 0; sample < length; ++sample)
+                channelData[sample] *= startGain + gainStep * (float)sample;
+        }
+
+        writePosition = (writePosition + length) & ringMask;
+    }
+}
+
+void FaucetFlutter::reset()
+{
+    std::fill(inputRing.begin(), inputRing.end(), 0.0f);
+    std::fill(combRing.begin(), combRing.end(), 0.0f);
+    writePosition = 0;
+
+    hydroPhase = 0.0f;
+    hydroRate = 6.0f;
+    hydroShape = 1.0f;
+    tremoloGain = 1.0f;
+
+    flickPosition = 1.0f;
+    flickIncrement = 0.0f;
+    flickDepthSamples = 0.0f;
+    flickDelay = 0.0f;
+
+    combDelay = juce::roundToInt(currentSampleRate / 2000.0);
+    combFeedback = 0.0f;
+    for (int ch = 0; ch < maxChannels; ++ch)
+        combDamping[ch] = 0.0f;
+}
+
+//==============================================================================
+// DrainResonator Implementation
+//==============================================================================
+DrainResonator::DrainResonator()
+{
+}
+
+void DrainResonator::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+    qualityChanged();
+    clogLowpassCoeff = 1.0f - (float)std::exp(-juce::MathConstants<double>::twoPi * 700.0 / sampleRate);
+
+    reset();
+}
+
+void DrainResonator::qualityChanged()
+{
+    controlInterval = getControlInterval();
+
+    const double controlRate = currentSampleRate / controlInterval;
+    peakDecay = (float)std::exp(-1.0 / (0.6 * controlRate));        // Peaks ring out over ~0.6 s
+    glideCoeff = 1.0f - (float)std::exp(-1.0 / (0.03 * controlRate)); // 30 ms retune glide
+}
+
+void DrainResonator::retunePeak(int index, float strength, SeededRandom& rng)
+{
+    // Log-uniform 200-800 Hz pipe peaks; a clogged drain is lower, wider and wobblier
+    const float lowHz = clogMode ? 150.0f : 200.0f;
+    const float highHz = clogMode ? 450.0f : 800.0f;
+    targetFrequency[index] = lowHz * std::pow(highHz / lowHz, rng.nextFloat());
+    resonanceQ[index] = clogMode ? 3.0f + 3.0f * rng.nextFloat() : 8.0f + 22.0f * rng.nextFloat();
+    flutterRate[index] = 5.0f + 6.0f * rng.nextFloat();
+    peakLevel[index] = juce::jmax(peakLevel[index], strength);
+}
+
+void DrainResonator::updateControl(float level, juce::uint64 position)
+{
+    auto& rng = getRandom(0);
+    rng.seekToSample(position);
+
+    // Amplitude trigger with hysteresis: each loud syllable retunes a few peaks
+    constexpr float triggerLevel = 0.25f;
+    constexpr float rearmLevel = 0.12f;
+
+    if (triggerArmed && level > triggerLevel)
+    {
+        triggerArmed = false;
+        const float strength = juce::jmin(1.0f, level * 2.0f);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            retunePeak(nextPeak, strength, rng);
+            nextPeak = nextPeak + 1 < numResonators ? nextPeak + 1 : numHumResonators;
+        }
+    }
+    else if (! triggerArmed && level < rearmLevel)
+    {
+        triggerArmed = true;
+    }
+
+    // Clog mode: the whole bank gurgles in and out
+    if (clogMode)
+        clogGurgle += 0.15f * ((0.4f + 0.6f * rng.nextFloat()) - clogGurgle);
+    else
+        clogGurgle = 1.0f;
+
+    // Hum lanes track the hum setting
+    targetFrequency[0] = humFrequency;
+    targetFrequency[1] = humFrequency * 2.0f;
+    peakLevel[0] = humLevel;
+    peakLevel[1] = humLevel * 0.5f;
+
+    const float controlPeriod = (float)controlInterval / (float)currentSampleRate;
+    const float flutterDepth = clogMode ? 0.03f : 0.004f;  // Metallic pipe flutter
+    const float nyquistGuard = 0.45f * (float)currentSampleRate;
+    constexpr float bankGain = 0.35f;  // Several 0 dB peaks can land on one harmonic; keep them beneath the voice
+
+    for (int k = 0; k < numResonators; ++k)
+    {
+        currentFrequency[k] += glideCoeff * (targetFrequency[k] - currentFrequency[k]);
+
+        flutterPhase[k] += juce::MathConstants<float>::twoPi * flutterRate[k] * controlPeriod;
+        if (flutterPhase[k] > juce::MathConstants<float>::twoPi)
+            flutterPhase[k] -= juce::MathConstants<float>::twoPi;
+
+        float frequency = currentFrequency[k];
+        if (k >= numHumResonators)
+        {
+            frequency *= 1.0f + flutterDepth * std::sin(flutterPhase[k]);
+            peakLevel[k] *= peakDecay;
+        }
+
+        frequency = juce::jlimit(20.0f, nyquistGuard, frequency);
+
+        // RBJ constant 0 dB peak bandpass, normalised by a0
+        const float w0 = juce::MathConstants<float>::twoPi * frequency / (float)currentSampleRate;
+        const float alpha = std::sin(w0) / (2.0f * resonanceQ[k]);
+        const float norm = 1.0f / (1.0f + alpha);
+
+        b0[k] = alpha * norm;
+        a1[k] = 2.0f * std::cos(w0) * norm;
+        a2[k] = (1.0f - alpha) * norm;
+        gainStep[k] = (peakLevel[k] * clogGurgle * bankGain - gain[k]) / (float)controlInterval;
+    }
+}
+
+void DrainResonator::processBlock(const juce::dsp::AudioBlock<float>& block)
+{
+    if (!enabled || resonance <= 0.0f || analysis == nullptr)
+        return;
+
+    const int numSamples = (int)block.getNumSamples();
+    const int numChannels = juce::jmin((int)block.getNumChannels(), maxChannels);
+    const auto& envelopes = analysis->getEnvelopes();
+    const float outputGain = resonance * mix;
+
+    for (int start = 0; start < numSamples; start += controlInterval)
+    {
+        const int length = juce::jmin(controlInterval, numSamples - start);
+
+        float level = 0.0f;
+        if (start < envelopes.getNumSamples())
+            for (int channel = 0; channel < numChannels; ++channel)
+                level = juce::jmax(level, envelopes.getPeak(channel)[start]);
+
+        updateControl(level, blockStartSample + (juce::uint64)start);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* channelData = block.getChannelPointer((size_t)channel) + start;
+            float* state1 = y1[channel];
+            float* state2 = y2[channel];
+
+            for (int sample = 0; sample < length; ++sample)
+            {
+                const float input = channelData[sample];
+                const auto ramp = Lanes::expand((float)sample);
+                const auto excitation = Lanes::expand(input - x2[channel]);
+                x2[channel] = x1[channel];
+                x1[channel] = input;
+
+                // The whole bank, a register of filters at a time; lanes are only
+                // summed once, after the last register
+                auto weighted = Lanes::expand(0.0f);
+                for (int k = 0; k < numResonators; k += (int)Lanes::SIMDNumElements)
+                {
+                    const auto previous = Lanes::fromRawArray(state1 + k);
+                    const auto y = Lanes::fromRawArray(b0 + k) * excitation
+                                 + Lanes::fromRawArray(a1 + k) * previous
+                                 - Lanes::fromRawArray(a2 + k) * Lanes::fromRawArray(state2 + k);
+                    previous.copyToRawArray(state2 + k);
+                    y.copyToRawArray(state1 + k);
+                    weighted = weighted + (Lanes::fromRawArray(gain + k) + Lanes::fromRawArray(gainStep + k) * ramp) * y;
+                }
+
+                float wet = weighted.sum();
+
+                if (clogMode)
+                {
+                    clogState[channel] += clogLowpassCoeff * (wet - clogState[channel]);
+                    wet = clogState[channel];
+                }
+
+                channelData[sample] = input + wet * outputGain;
+            }
+        }
+
+        // Both channels ran the same ramp; move the gains on once per tick
+        for (int k = 0; k < numResonators; ++k)
+            gain[k] += gainStep[k] * (float)length;
+    }
+}
+
+void DrainResonator::reset()
+{
+    for (int k = 0; k < numResonators; ++k)
+    {
+        targetFrequency[k] = currentFrequency[k] = 200.0f * std::pow(4.0f, (float)k / (float)numResonators);
+        resonanceQ[k] = k < numHumResonators ? 20.0f : 12.0f;
+        peakLevel[k] = 0.0f;
+        flutterPhase[k] = 0.0f;
+        flutterRate[k] = 7.0f;
+        b0[k] = a1[k] = a2[k] = gain[k] = gainStep[k] = 0.0f;
+
+        for (int ch = 0; ch < maxChannels; ++ch)
+            y1[ch][k] = y2[ch][k] = 0.0f;
+    }
+
+    for (int ch = 0; ch < maxChannels; ++ch)
+        x1[ch] = x2[ch] = clogState[ch] = 0.0f;
+
+    clogGurgle = 1.0f;
+    triggerArmed = true;
+    nextPeak = numHumResonators;
+}
+
+//==============================================================================
+// RubberDuckFM Implementation
+//==============================================================================
+RubberDuckFM::RubberDuckFM()
+{
+}
+
+void RubberDuckFM::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+
+    // Quack bursts ring out over ~120 ms
+    quackDecay = (float)std::exp(-1.0 / (0.12 * sampleRate));
+}
+
+void RubberDuckFM::processBlock(const juce::dsp::AudioBlock<float>& block)
+{
+    if (!enabled || quackIntensity <= 0.0f)
+        return;
+
+    // Quack mode: formant-following FM synthesis
+    const int numSamples = (int)block.getNumSamples();
+    const auto& onsets = getOnsets();
+
+    for (int channel = 0; channel < (int)block.getNumChannels(); ++channel)
+    {
+        auto* channelData = block.getChannelPointer((size_t)channel);
+        float& envelope = quackEnvelope[juce::jmin(channel, 1)];
+        int nextOnset = 0;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            // Loud syllables kick off a quack burst
+            if (nextOnset < onsets.size() && onsets[nextOnset].sampleOffset == sample)
+                envelope = juce::jmax(envelope, onsets[nextOnset++].strength);
+
+            envelope *= quackDecay;
+
+            // Simple FM wobble, deepened while a quack rings
+            float modulator = std::sin(fmPhase) * quackIntensity * (1.0f + 2.0f * envelope);
+            fmPhase += (800.0f / (float)currentSampleRate) * juce::MathConstants<float>::twoPi;
+
+            if (fmPhase > juce::MathConstants<float>::twoPi)
+                fmPhase -= juce::MathConstants<float>::twoPi;
+
+            // Mix original with FM-modulated version
+            float original = channelData[sample];
+            float modulated = original * (1.0f + modulator * 0.3f);
+            channelData[sample] = original * (1.0f - mix) + modulated * mix;
+        }
+    }
+}
+
+void RubberDuckFM::reset()
+{
+    fmPhase = 0.0f;
+    quackEnvelope[0] = quackEnvelope[1] = 0.0f;
+}
+
+//==============================================================================
+// SoapBarGlitch Implementation
+//==============================================================================
+SoapBarGlitch::SoapBarGlitch()
+{
+}
+
+void SoapBarGlitch::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+
+    grainBuffer.prepare([sampleRate, samplesPerBlock]
+                        {
+                            auto grains = std::make_unique<juce::dsp::DelayLine<float>>(88200);
+                            grains->prepare({sampleRate, (juce::uint32)samplesPerBlock, 1});
+                            return grains;
+                        },
+                        sampleRate, true, isActive());
+}
+
+void SoapBarGlitch::processBlock(const juce::dsp::AudioBlock<float>& block)
+{
+    auto* grains = grainBuffer.acquire(isActive(), (int)block.getNumSamples());
+    if (!isActive() || grains == nullptr)
+        return;
+
+    const int numSamples = (int)block.getNumSamples();
+
+    for (int channel = 0; channel < (int)block.getNumChannels(); ++channel)
+    {
+        auto* channelData = block.getChannelPointer((size_t)channel);
+        auto& rng = getRandom(channel);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            float input = channelData[sample];
+            rng.seekToSample(blockStartSample + (juce::uint64)sample);
+
+            // Push to grain buffer
+            grains->pushSample(0, input);
 
             // Random "slip" events - like soap slipping from hands
-            if (random.nextFloat() < slipperiness * 0.001f)
+            if (rng.nextFloat() < slipperiness * 0.001f)
             {
                 // Trigger a slip!
-                targetSlip = (random.nextFloat() * 2.0f - 1.0f) * 1000.0f; // Up to 1000 samples
-                grainSize = 128 + random.nextInt(512);
+                targetSlip = (rng.nextFloat() * 2.0f - 1.0f) * 1000.0f; // Up to 1000 samples
+                grainSize = 128 + rng.nextInt(512);
             }
 
             // Smooth the slip amount
@@ -796,14 +1478,14 @@ void SoapBarGlitch::process(juce::AudioBuffer<float>& buffer)
             float readPos = std::abs(slipAmount) + 1.0f;
 
             // Pop from grain buffer with variable delay (creates pitch shifting effect)
-            float grainSample = grainBuffer.popSample(0, readPos);
+            float grainSample = grains->popSample(0, readPos);
 
             // Apply soapy blur (crossfade smear)
             if (soapyBlur > 0.0f)
             {
                 // Average with neighboring positions for blur
-                float blurSample1 = grainBuffer.popSample(0, readPos + 2.0f);
-                float blurSample2 = grainBuffer.popSample(0, readPos + 4.0f);
+                float blurSample1 = grains->popSample(0, readPos + 2.0f);
+                float blurSample2 = grains->popSample(0, readPos + 4.0f);
                 grainSample = grainSample * (1.0f - soapyBlur * 0.5f) +
                              (blurSample1 + blurSample2) * soapyBlur * 0.25f;
             }
@@ -814,7 +1496,7 @@ void SoapBarGlitch::process(juce::AudioBuffer<float>& buffer)
             if (grainPhase >= 1.0f)
             {
                 grainPhase -= 1.0f;
-                grainSize = 256 + random.nextInt(512);
+                grainSize = 256 + rng.nextInt(512);
             }
 
             // Mix
@@ -826,69 +1508,822 @@ void SoapBarGlitch::process(juce::AudioBuffer<float>& buffer)
 
 void SoapBarGlitch::reset()
 {
-    grainBuffer.reset();
+    if (auto* grains = grainBuffer.get())
+        grains->reset();
+    grainPhase = 0.0f;
+    slipAmount = 0.0f;
+    targetSlip = 0.0f;
+    grainSize = 512;
+}
+
+//==============================================================================
+// BathroomFanChorus Implementation
+//==============================================================================
+BathroomFanChorus::BathroomFanChorus()
+{
+}
+
+void BathroomFanChorus::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+    qualityChanged();
+
+    // Longest tap: 7 ms base + 15 voice spacings + full sweep + jitter, kept under 25 ms
+    const int longestDelay = (int)std::ceil(0.025 * sampleRate) + 2;
+    ringSize = juce::nextPowerOfTwo(longestDelay + maxControlInterval);
+    ringMask = ringSize - 1;
+    ring.assign((size_t)(maxChannels * ringSize), 0.0f);
+
+    wetBuffer.setSize(maxChannels, maxControlInterval);
+
+    reset();
+}
+
+void BathroomFanChorus::qualityChanged()
+{
+    controlInterval = getControlInterval();
+    cubicTaps = quality == ProcessingQuality::High;
+}
+
+void BathroomFanChorus::updateControl(juce::uint64 position)
+{
+    auto& rng = getRandom(0);
+    rng.seekToSample(position);
+
+    const float sampleRate = (float)currentSampleRate;
+    const float controlPeriod = (float)controlInterval / sampleRate;
+    const float twoPi = juce::MathConstants<float>::twoPi;
+
+    // Broken fan: sputters in and out for 20-120 ms at a time
+    if (brokenFan)
+    {
+        if (sputterTicksLeft > 0)
+        {
+            --sputterTicksLeft;
+        }
+        else if (rng.nextFloat() < 1.2f * controlPeriod)
+        {
+            sputterTicksLeft = (int)((0.02f + 0.1f * rng.nextFloat()) / controlPeriod);
+            sputterDepth = 0.05f + 0.3f * rng.nextFloat();
+        }
+    }
+    else
+    {
+        sputterTicksLeft = 0;
+    }
+
+    const float targetWetGain = sputterTicksLeft > 0 ? sputterDepth : 1.0f;
+    wetGain += 0.5f * (targetWetGain - wetGain);
+
+    // Unbalanced rotor: RPM wobbles once per turn and drifts; a sputtering fan slows
+    rpmDrift = juce::jlimit(-0.2f, 0.2f, rpmDrift + (rng.nextFloat() - 0.5f) * 0.05f);
+    float rotorRate = (2.0f + 18.0f * fanSpeed) * (1.0f + 0.12f * std::sin(rotorPhase) + rpmDrift);
+    if (sputterTicksLeft > 0)
+        rotorRate *= 0.6f;
+
+    rotorPhase += twoPi * rotorRate * controlPeriod;
+    if (rotorPhase > twoPi)
+        rotorPhase -= twoPi;
+
+    // Taps are spaced around the rotor like blades, with an irregular (non-sine) sweep.
+    // All slots are updated so voices switched on later start from a current delay.
+    const float sweepDepth = (0.0015f + 0.0025f * fanSpeed) * sampleRate;
+    const float bladeSpacing = twoPi / (float)numVoices;
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        jitter[v] += 0.2f * ((rng.nextFloat() * 2.0f - 1.0f) - jitter[v]);
+
+        const float blade = rotorPhase + bladeSpacing * (float)v;
+        const float sweep = (std::sin(blade) + 0.35f * std::sin(2.0f * blade + 1.3f)) / 1.35f;
+
+        currentDelay[v] = (0.007f + 0.00085f * (float)v) * sampleRate
+                        + sweepDepth * (0.5f + 0.5f * sweep)
+                        + 0.0004f * sampleRate * jitter[v];
+    }
+
+    // HF shimmer pulses with the three blades passing
+    shimmerGain = 0.25f * fanSpeed * (0.5f + 0.5f * std::sin(3.0f * rotorPhase));
+}
+
+void BathroomFanChorus::processBlock(const juce::dsp::AudioBlock<float>& block)
+{
+    if (!enabled || fanAmount <= 0.0f)
+        return;
+
+    const int numSamples = (int)block.getNumSamples();
+    const int numChannels = juce::jmin((int)block.getNumChannels(), maxChannels);
+    const float voiceGain = 1.0f / std::sqrt((float)numVoices);
+    const float amount = fanAmount * mix;
+    const float shimmerCoeff = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * 3000.0f / (float)currentSampleRate);
+
+    for (int start = 0; start < numSamples; start += controlInterval)
+    {
+        const int length = juce::jmin(controlInterval, numSamples - start);
+        const float startWetGain = wetGain;
+        const float startShimmer = shimmerGain;
+
+        std::copy(std::begin(currentDelay), std::end(currentDelay), std::begin(previousDelay));
+        updateControl(blockStartSample + (juce::uint64)start);
+
+        const float shimmerStep = (shimmerGain - startShimmer) / (float)length;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* channelData = block.getChannelPointer((size_t)channel) + start;
+            float* line = ring.data() + channel * ringSize;
+            float* wet = wetBuffer.getWritePointer(channel);
+
+            // Write the whole control block first; every tap is at least 7 ms back
+            for (int sample = 0; sample < length; ++sample)
+                line[(writePosition + sample) & ringMask] = channelData[sample];
+
+            juce::FloatVectorOperations::clear(wet, length);
+
+            for (int v = 0; v < numVoices; ++v)
+            {
+                const float startDelay = previousDelay[v];
+                const float delayStep = (currentDelay[v] - startDelay) / (float)length;
+
+                if (cubicTaps)
+                {
+                    // 4-point Hermite: flatter top end on the swept taps
+                    for (int sample = 0; sample < length; ++sample)
+                    {
+                        const float readPosition = (float)(writePosition + sample) - (startDelay + delayStep * (float)sample);
+                        const int index = (int)std::floor(readPosition);
+                        const float frac = readPosition - (float)index;
+                        const float y0 = line[(index - 1) & ringMask];
+                        const float y1 = line[index & ringMask];
+                        const float y2 = line[(index + 1) & ringMask];
+                        const float y3 = line[(index + 2) & ringMask];
+                        const float c1 = 0.5f * (y2 - y0);
+                        const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+                        const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+                        wet[sample] += ((c3 * frac + c2) * frac + c1) * frac + y1;
+                    }
+                }
+                else
+                {
+                    for (int sample = 0; sample < length; ++sample)
+                    {
+                        const float readPosition = (float)(writePosition + sample) - (startDelay + delayStep * (float)sample);
+                        const int index = (int)std::floor(readPosition);
+                        const float frac = readPosition - (float)index;
+                        const float a = line[index & ringMask];
+                        wet[sample] += a + frac * (line[(index + 1) & ringMask] - a);
+                    }
+                }
+            }
+
+            // Shimmer: the wet's top end, pulsed by the blades
+            float lowpass = shimmerState[channel];
+            for (int sample = 0; sample < length; ++sample)
+            {
+                lowpass += shimmerCoeff * (wet[sample] - lowpass);
+                wet[sample] += (wet[sample] - lowpass) * (startShimmer + shimmerStep * (float)sample);
+            }
+            shimmerState[channel] = lowpass;
+
+            // Sputter events land on the wet signal as one ramp per control block
+            wetBuffer.applyGainRamp(channel, 0, length, startWetGain * voiceGain, wetGain * voiceGain);
+
+            juce::FloatVectorOperations::multiply(channelData, 1.0f - 0.5f * amount, length);
+            juce::FloatVectorOperations::addWithMultiply(channelData, wet, amount, length);
+        }
+
+        writePosition = (writePosition + length) & ringMask;
+    }
+}
+
+void BathroomFanChorus::reset()
+{
+    std::fill(ring.begin(), ring.end(), 0.0f);
+    writePosition = 0;
+
+    rotorPhase = 0.0f;
+    rpmDrift = 0.0f;
+    wetGain = 1.0f;
+    sputterTicksLeft = 0;
+    sputterDepth = 1.0f;
+    shimmerGain = 0.0f;
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        jitter[v] = 0.0f;
+        currentDelay[v] = previousDelay[v] = (0.007f + 0.00085f * (float)v) * (float)currentSampleRate;
+    }
+
+    for (int ch = 0; ch < maxChannels; ++ch)
+        shimmerState[ch] = 0.0f;
+}
+
+//==============================================================================
+// MildewyWallFilter Implementation
+//==============================================================================
+MildewyWallFilter::MildewyWallFilter()
+{
+}
+
+void MildewyWallFilter::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+    qualityChanged();
+    reset();
+}
+
+void MildewyWallFilter::qualityChanged()
+{
+    controlInterval = getControlInterval();
+
+    const double controlRate = currentSampleRate / controlInterval;
+    burstAttack = 1.0f - (float)std::exp(-1.0 / (0.008 * controlRate));  // 8 ms spike
+    burstDecay = (float)std::exp(-1.0 / (0.25 * controlRate));           // 250 ms rot
+}
+
+MildewyWallFilter::SvfCoefficients MildewyWallFilter::makeLowPass(float frequencyHz, float q) const
+{
+    const float g = std::tan(juce::MathConstants<float>::pi * juce::jmin(frequencyHz, 0.45f * (float)currentSampleRate) / (float)currentSampleRate);
+    const float k = 1.0f / q;
+
+    SvfCoefficients c;
+    c.a1 = 1.0f / (1.0f + g * (g + k));
+    c.a2 = g * c.a1;
+    c.a3 = g * c.a2;
+    c.m0 = 0.0f;
+    c.m1 = 0.0f;
+    c.m2 = 1.0f;
+    return c;
+}
+
+MildewyWallFilter::SvfCoefficients MildewyWallFilter::makeBell(float frequencyHz, float q, float gainDb) const
+{
+    const float g = std::tan(juce::MathConstants<float>::pi * juce::jmin(frequencyHz, 0.45f * (float)currentSampleRate) / (float)currentSampleRate);
+    const float A = std::pow(10.0f, gainDb / 40.0f);
+    const float k = 1.0f / (q * A);
+
+    SvfCoefficients c;
+    c.a1 = 1.0f / (1.0f + g * (g + k));
+    c.a2 = g * c.a1;
+    c.a3 = g * c.a2;
+    c.m0 = 1.0f;
+    c.m1 = k * (A * A - 1.0f);
+    c.m2 = 0.0f;
+    return c;
+}
+
+void MildewyWallFilter::rollMoldbursts(juce::uint64 position)
+{
+    if (moldburstRate <= 0.0f)
+        return;
+
+    // One spike every 1.5-8 s on average, sooner with a higher rate. Each slot
+    // starting in this control block rolls from its own position, so a loop,
+    // a seek or a split render meets the same spikes at the same samples.
+    const float meanIntervalSamples = (8.0f - 6.5f * moldburstRate) * (float)currentSampleRate;
+    const float slotProbability = (float)burstSlotSize / meanIntervalSamples;
+    const juce::uint64 end = position + (juce::uint64)controlInterval;
+    auto& rng = getRandom(1);
+
+    for (auto slot = (position + burstSlotSize - 1) / burstSlotSize * burstSlotSize; slot < end; slot += burstSlotSize)
+    {
+        rng.seekToSample(slot);
+        if (rng.nextFloat() < slotProbability)
+        {
+            burstFrequency = 800.0f * std::pow(2.5f, rng.nextFloat());  // 800 Hz - 2 kHz
+            burstTarget = 0.5f + 0.5f * rng.nextFloat();
+        }
+    }
+}
+
+void MildewyWallFilter::updateControl(juce::uint64 position)
+{
+    rollMoldbursts(position);
+
+    if (burstTarget > 0.0f)
+    {
+        burstLevel += burstAttack * (burstTarget - burstLevel);
+        if (burstLevel >= 0.95f * burstTarget)
+            burstTarget = 0.0f;  // Peaked - let it rot away
+    }
+    else
+    {
+        burstLevel *= burstDecay;
+    }
+
+    // Slow reflecting random walks (each crosses its range in a few seconds)
+    auto& rng = getRandom(0);
+    rng.seekToSample(position);
+
+    auto walk = [&rng](float& value)
+    {
+        value += (rng.nextFloat() - 0.5f) * 0.01f;
+        if (value < 0.0f) value = -value;
+        if (value > 1.0f) value = 2.0f - value;
+    };
+
+    walk(smotherWalk);
+    walk(midFrequencyWalk);
+    walk(midDepthWalk);
+    walk(resonanceWalk);
+
+    // HF smothering: 16 kHz down towards 2 kHz as the mildew spreads
+    const float smotherHz = 16000.0f * std::pow(0.125f, mildew * (0.5f + 0.5f * smotherWalk));
+
+    currentCoeffs[HighSmother] = makeLowPass(smotherHz, 0.6f);
+    currentCoeffs[MidDamp] = makeBell(500.0f * std::pow(4.0f, midFrequencyWalk), 1.2f, -mildew * (3.0f + 9.0f * midDepthWalk));
+    currentCoeffs[DampResonance] = makeBell(180.0f * std::pow(2.0f, resonanceWalk), 3.0f, mildew * 5.0f);
+    currentCoeffs[Moldburst] = makeBell(burstFrequency, 4.0f, mildew * 14.0f * burstLevel);
+}
+
+void MildewyWallFilter::processBlock(const juce::dsp::AudioBlock<float>& block)
+{
+    if (!enabled || mildew <= 0.0f)
+        return;
+
+    const int numSamples = (int)block.getNumSamples();
+    const int numChannels = juce::jmin((int)block.getNumChannels(), maxChannels);
+
+    for (int start = 0; start < numSamples; start += controlInterval)
+    {
+        const int length = juce::jmin(controlInterval, numSamples - start);
+
+        std::copy(std::begin(currentCoeffs), std::end(currentCoeffs), std::begin(previousCoeffs));
+        updateControl(blockStartSample + (juce::uint64)start);
+
+        // Per-sample coefficient steps, so the cascade glides to the new targets
+        SvfCoefficients steps[numStages];
+        const float invLength = 1.0f / (float)length;
+        for (int s = 0; s < numStages; ++s)
+        {
+            const auto& from = previousCoeffs[s];
+            const auto& to = currentCoeffs[s];
+            steps[s] = { (to.a1 - from.a1) * invLength, (to.a2 - from.a2) * invLength, (to.a3 - from.a3) * invLength,
+                         (to.m0 - from.m0) * invLength, (to.m1 - from.m1) * invLength, (to.m2 - from.m2) * invLength };
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* channelData = block.getChannelPointer((size_t)channel) + start;
+            float* state1 = ic1[channel];
+            float* state2 = ic2[channel];
+
+            for (int sample = 0; sample < length; ++sample)
+            {
+                const float input = channelData[sample];
+                const float t = (float)(sample + 1);
+                float y = input;
+
+                for (int s = 0; s < numStages; ++s)
+                {
+                    const auto& from = previousCoeffs[s];
+                    const auto& step = steps[s];
+
+                    const float a1 = from.a1 + step.a1 * t;
+                    const float a2 = from.a2 + step.a2 * t;
+                    const float a3 = from.a3 + step.a3 * t;
+
+                    const float v3 = y - state2[s];
+                    const float v1 = a1 * state1[s] + a2 * v3;
+                    const float v2 = state2[s] + a2 * state1[s] + a3 * v3;
+                    state1[s] = 2.0f * v1 - state1[s];
+                    state2[s] = 2.0f * v2 - state2[s];
+
+                    y = (from.m0 + step.m0 * t) * y + (from.m1 + step.m1 * t) * v1 + (from.m2 + step.m2 * t) * v2;
+                }
+
+                channelData[sample] = input + (y - input) * mix;
+            }
+        }
+    }
+}
+
+void MildewyWallFilter::reset()
+{
+    for (int s = 0; s < numStages; ++s)
+    {
+        previousCoeffs[s] = currentCoeffs[s] = {};  // Pass-through until the first control tick
+
+        for (int ch = 0; ch < maxChannels; ++ch)
+            ic1[ch][s] = ic2[ch][s] = 0.0f;
+    }
+
+    smotherWalk = midFrequencyWalk = midDepthWalk = resonanceWalk = 0.5f;
+
+    burstTarget = 0.0f;
+    burstLevel = 0.0f;
+}
+
+//==============================================================================
+// VoiceIdentityBuilder Implementation
+//==============================================================================
+VoiceIdentityBuilder::VoiceIdentityBuilder()
+{
+    // Hann window table (one extra point so interpolation never wraps)
+    windowTable = SharedTables::getHannWindow(windowTableSize + 1);
+
+    randomizeIdentities(identitySeed);
+}
+
+void VoiceIdentityBuilder::prepare(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    currentBlockSize = samplesPerBlock;
+
+    // Longest lag + the largest grain read span at the lowest tracked pitch
+    const double maxLagSeconds = 0.05 + 1.25 * 2.0 / PitchTracker::minFrequencyHz;
+    const int historySize = juce::nextPowerOfTwo((int)std::ceil(maxLagSeconds * sampleRate) + 4);
+    history.assign((size_t)historySize, 0.0f);
+    historyMask = historySize - 1;
+
+    // Brightness tilt pivots around ~2 kHz
+    tiltCoeff = 1.0f - (float)std::exp(-juce::MathConstants<double>::twoPi * 2000.0 / sampleRate);
+
+    reset();
+}
+
+void VoiceIdentityBuilder::randomizeIdentities(juce::uint32 newIdentitySeed)
+{
+    identitySeed = newIdentitySeed;
+
+    SeededRandom rng;
+    rng.setSeed(identitySeed, 17);
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        VoiceIdentity identity;
+        identity.formantScale = std::pow(2.0f, (rng.nextFloat() - 0.5f) * 0.5f);   // +/- a quarter octave
+        identity.timingMs = 8.0f + rng.nextFloat() * 27.0f;
+        identity.vibratoRateHz = 4.5f + rng.nextFloat() * 2.0f;
+        identity.vibratoCents = 5.0f + rng.nextFloat() * 20.0f;
+        identity.detuneCents = (rng.nextFloat() - 0.5f) * 24.0f;
+        identity.brightness = (rng.nextFloat() - 0.5f);
+        identity.pan = (v % 2 == 0 ? -1.0f : 1.0f) * (0.3f + 0.6f * rng.nextFloat());
+        setIdentity(v, identity);
+    }
+}
+
+void VoiceIdentityBuilder::setIdentity(int voice, const VoiceIdentity& identity)
+{
+    if (voice < 0 || voice >= maxVoices)
+        return;
+
+    auto& target = identities[voice];
+    target = identity;
+    target.formantScale = juce::jlimit(0.8f, 1.25f, identity.formantScale);
+    target.timingMs = juce::jlimit(0.0f, 50.0f, identity.timingMs);
+    target.brightness = juce::jlimit(-1.0f, 1.0f, identity.brightness);
+    target.pan = juce::jlimit(-1.0f, 1.0f, identity.pan);
+
+    // Constant-power pan
+    const float angle = (target.pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+    voices[voice].gainLeft = std::cos(angle);
+    voices[voice].gainRight = std::sin(angle);
+}
+
+float VoiceIdentityBuilder::readHistory(float position) const
+{
+    const int index = (int)position;
+    const float frac = position - (float)index;
+    const float a = history[(size_t)(index & historyMask)];
+    const float b = history[(size_t)((index + 1) & historyMask)];
+    return a + frac * (b - a);
+}
+
+void VoiceIdentityBuilder::startGrain(VoiceState& voice, const VoiceIdentity& identity, float period)
+{
+    // Vibrato and detune set the grain spacing (pitch); the period sets grain size
+    const float vibrato = std::sin(voice.vibratoPhase * juce::MathConstants<float>::twoPi) * identity.vibratoCents;
+    const float pitchRatio = std::pow(2.0f, (identity.detuneCents + vibrato) / 1200.0f);
+    const float hop = period / pitchRatio;
+
+    voice.samplesToNextGrain += hop;
+    voice.vibratoPhase += hop * identity.vibratoRateHz / (float)currentSampleRate;
+    if (voice.vibratoPhase >= 1.0f)
+        voice.vibratoPhase -= 1.0f;
+
+    // Reuse a free slot, or steal the grain closest to finishing
+    Grain* slot = &voice.grains[0];
+    for (auto& grain : voice.grains)
+    {
+        if (! grain.active) { slot = &grain; break; }
+        if (grain.windowPosition > slot->windowPosition) slot = &grain;
+    }
+
+    // Centre the two-period grain one (scaled) period behind the lagged read point;
+    // with playback rate < 2 it never catches up with the write head
+    const float lagSamples = identity.timingMs * 0.001f * (float)currentSampleRate;
+    float start = (float)writePosition - lagSamples - period * identity.formantScale;
+    while (start < 0.0f)
+        start += (float)history.size();
+
+    slot->readPosition = start;
+    slot->readIncrement = identity.formantScale;
+    slot->windowPosition = 0.0f;
+    slot->windowIncrement = 1.0f / (2.0f * period);
+    slot->active = true;
+}
+
+void VoiceIdentityBuilder::processBlock(const juce::dsp::AudioBlock<float>& block)
+{
+    if (!enabled || numVoices <= 0 || doubleLevel <= 0.0f || history.empty())
+        return;
+
+    const int numSamples = (int)block.getNumSamples();
+    const int numChannels = juce::jmin((int)block.getNumChannels(), 2);
+    if (numChannels == 0)
+        return;
+
+    auto* left = block.getChannelPointer((size_t)0);
+    auto* right = block.getChannelPointer((size_t)numChannels - 1);
+
+    // Grain period from the shared pitch tracker; unvoiced material gets 10 ms grains
+    float period = (float)currentSampleRate * 0.01f;
+    if (analysis != nullptr)
+    {
+        const auto& pitch = analysis->getPitch();
+        if (pitch.confidence > 0.6f && pitch.frequencyHz > 0.0f)
+            period = (float)currentSampleRate / pitch.frequencyHz;
+    }
+
+    const float historyLength = (float)history.size();
+    const float outputGain = doubleLevel * mix / std::sqrt((float)numVoices);
+    const float* window = windowTable->data();
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        history[(size_t)writePosition] = numChannels > 1 ? 0.5f * (left[sample] + right[sample]) : left[sample];
+
+        float wetLeft = 0.0f;
+        float wetRight = 0.0f;
+
+        for (int v = 0; v < numVoices; ++v)
+        {
+            auto& voice = voices[v];
+            const auto& identity = identities[v];
+
+            voice.samplesToNextGrain -= 1.0f;
+            if (voice.samplesToNextGrain <= 0.0f)
+                startGrain(voice, identity, period);
+
+            // Overlap-add the active grains
+            float voiceOut = 0.0f;
+            for (auto& grain : voice.grains)
+            {
+                if (! grain.active)
+                    continue;
+
+                const float tablePos = grain.windowPosition * (float)windowTableSize;
+                const int tableIndex = (int)tablePos;
+                const float gain = window[tableIndex] + (tablePos - (float)tableIndex) * (window[tableIndex + 1] - window[tableIndex]);
+                voiceOut += readHistory(grain.readPosition) * gain;
+
+                grain.readPosition += grain.readIncrement;
+                if (grain.readPosition >= historyLength)
+                    grain.readPosition -= historyLength;
+
+                grain.windowPosition += grain.windowIncrement;
+                if (grain.windowPosition >= 1.0f)
+                    grain.active = false;
+            }
+
+            // Brightness tilt around the one-pole low band
+            voice.tiltState += tiltCoeff * (voiceOut - voice.tiltState);
+            voiceOut += identity.brightness * (voiceOut - voice.tiltState);
+
+            wetLeft += voiceOut * voice.gainLeft;
+            wetRight += voiceOut * voice.gainRight;
+        }
+
+        writePosition = (writePosition + 1) & historyMask;
+
+        if (numChannels > 1)
+        {
+            left[sample] += wetLeft * outputGain;
+            right[sample] += wetRight * outputGain;
+        }
+        else
+        {
+            left[sample] += (wetLeft + wetRight) * 0.5f * outputGain;
+        }
+    }
+}
+
+void VoiceIdentityBuilder::reset()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    writePosition = 0;
+
+    for (int v = 0; v < maxVoices; ++v)
+    {
+        auto& voice = voices[v];
+        for (auto& grain : voice.grains)
+            grain.active = false;
+
+        // Stagger grain starts so the voices don't pulse together
+        voice.samplesToNextGrain = (float)v * 37.0f;
+        voice.vibratoPhase = (float)v / (float)maxVoices;
+        voice.tiltState = 0.0f;
+    }
 }
 
 //==============================================================================
 // VocalProcessor Implementation
 //==============================================================================
 VocalProcessor::VocalProcessor()
+    : modules { &pitchDriftBrain, &formantWhispers, &breathNoiseEngine, &timingWobble, &volumePersonality,
+                &porcelainReflections, &steamModulator, &rubberDuckFM, &soapBarGlitch, &voiceIdentityBuilder,
+                &drainResonator, &faucetFlutter, &bathroomFanChorus,
+                &mildewyWallFilter }
+{
+    for (auto* module : modules)
+        module->setAnalysis(&analysis);
+
+    // Fresh instances get their own seed; a saved session restores it via setSeed()
+    setSeed((juce::uint64)juce::Random::getSystemRandom().nextInt64());
+}
+
+void VocalProcessor::setSeed(juce::uint64 newSeed)
+{
+    seed = newSeed;
+
+    // Module ids are fixed so a saved seed keeps producing the same streams
+    for (size_t i = 0; i < modules.size(); ++i)
+        modules[i]->setRandomSeed(seed, (juce::uint32)(i + 1));
+}
+
+int VocalProcessor::getLatencySamples() const
 {
+    return juce::jmax(pitchDriftBrain.getLatencySamples(), formantWhispers.getLatencySamples());
+}
+
+void VocalProcessor::applyQuality(ProcessingQuality newQuality)
+{
+    appliedQuality = newQuality;
+
+    for (auto* module : modules)
+        module->setQuality(appliedQuality);
 }
 
 void VocalProcessor::prepare(double sampleRate, int samplesPerBlock)
 {
+    // Everything downstream only ever sees sub-blocks
+    juce::ignoreUnused(samplesPerBlock);
+
+    analysis.prepare(sampleRate, subBlockSize);
+
+    // Modules are always built for the user's tier; an offline upgrade is applied by process()
+    applyQuality(quality.load());
+
     // Prepare all modules
-    pitchDriftBrain.prepare(sampleRate, samplesPerBlock);
-    formantWhispers.prepare(sampleRate, samplesPerBlock);
-    breathNoiseEngine.prepare(sampleRate, samplesPerBlock);
-    timingWobble.prepare(sampleRate, samplesPerBlock);
-    volumePersonality.prepare(sampleRate, samplesPerBlock);
-    porcelainReflections.prepare(sampleRate, samplesPerBlock);
-    steamModulator.prepare(sampleRate, samplesPerBlock);
-    rubberDuckFM.prepare(sampleRate, samplesPerBlock);
-    soapBarGlitch.prepare(sampleRate, samplesPerBlock);
+    pitchDriftBrain.prepare(sampleRate, subBlockSize);
+    formantWhispers.prepare(sampleRate, subBlockSize);
+    breathNoiseEngine.prepare(sampleRate, subBlockSize);
+    timingWobble.prepare(sampleRate, subBlockSize);
+    volumePersonality.prepare(sampleRate, subBlockSize);
+    porcelainReflections.prepare(sampleRate, subBlockSize);
+    steamModulator.prepare(sampleRate, subBlockSize);
+    faucetFlutter.prepare(sampleRate, subBlockSize);
+    drainResonator.prepare(sampleRate, subBlockSize);
+    rubberDuckFM.prepare(sampleRate, subBlockSize);
+    soapBarGlitch.prepare(sampleRate, subBlockSize);
+    bathroomFanChorus.prepare(sampleRate, subBlockSize);
+    mildewyWallFilter.prepare(sampleRate, subBlockSize);
+    voiceIdentityBuilder.prepare(sampleRate, subBlockSize);
 
     // Allocate dry buffer for wet/dry mixing
-    dryBuffer.setSize(2, samplesPerBlock);
+    dryBuffer.setSize(2, subBlockSize);
 }
 
 void VocalProcessor::process(juce::AudioBuffer<float>& buffer)
 {
-    // Store dry signal
-    dryBuffer.makeCopyOf(buffer, true);
+    juce::dsp::AudioBlock<float> block(buffer);
+    process(juce::dsp::ProcessContextReplacing<float>(block));
+}
+
+void VocalProcessor::process(const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    render(context.getOutputBlock(), nullptr, context.isBypassed);
+}
+
+void VocalProcessor::process(const juce::dsp::ProcessContextNonReplacing<float>& context)
+{
+    const auto& inputBlock = context.getInputBlock();
+    auto& outputBlock = context.getOutputBlock();
+    jassert(inputBlock.getNumChannels() == outputBlock.getNumChannels()
+            && inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+    // Modules run in place on the output; the untouched input is the dry signal
+    outputBlock.copyFrom(inputBlock);
+    render(outputBlock, &inputBlock, context.isBypassed);
+}
+
+void VocalProcessor::render(const juce::dsp::AudioBlock<float>& output, const juce::dsp::AudioBlock<const float>* separateInput, bool bypassed)
+{
+    // Every caller (plugin, pipe, tests, batch renders) is checked, not just processBlock
+    SCHLOMO_REALTIME_SECTION("VocalProcessor");
+    const int numSamples = (int)output.getNumSamples();
+
+    // A bypassed block still moves the render timeline on
+    if (bypassed)
+    {
+        renderPosition += (juce::uint64)numSamples;
+        return;
+    }
+
+    // Offline bounce: upgrade to High in place (allocation-free), back again for playback
+    const auto effectiveQuality = offlineRendering ? ProcessingQuality::High : quality.load();
+    if (effectiveQuality != appliedQuality)
+        applyQuality(effectiveQuality);
+
+    // Store dry signal into the buffer sized in prepare (never reallocates here)
+    jassert(separateInput != nullptr || output.getNumChannels() <= (size_t)dryBuffer.getNumChannels());
+    const auto dryCopy = juce::dsp::AudioBlock<float>(dryBuffer).getSubsetChannelBlock(0, juce::jmin(output.getNumChannels(), (size_t)dryBuffer.getNumChannels()));
+
+    // Cut on the absolute sub-block grid, so a 64-sample live buffer and a
+    // 4096-sample mixdown buffer give every module identical blocks
+    for (int start = 0; start < numSamples;)
+    {
+        const int toGrid = subBlockSize - (int)(renderPosition % (juce::uint64)subBlockSize);
+        const int length = juce::jmin(toGrid, numSamples - start);
+        const auto block = output.getSubBlock((size_t)start, (size_t)length);
+
+        if (separateInput != nullptr)
+        {
+            processSubBlock(block, separateInput->getSubBlock((size_t)start, (size_t)length));
+        }
+        else
+        {
+            const auto dry = dryCopy.getSubBlock(0, (size_t)length);
+            dry.copyFrom(block);
+            processSubBlock(block, dry);
+        }
+
+        start += length;
+    }
+}
+
+void VocalProcessor::processSubBlock(juce::dsp::AudioBlock<float> block, const juce::dsp::AudioBlock<const float>& dry)
+{
+    const int numSamples = (int)block.getNumSamples();
+    const juce::dsp::ProcessContextReplacing<float> context(block);
+
+    // Address every random stream by absolute render position
+    for (auto* module : modules)
+        module->setBlockStartSample(renderPosition);
+
+    // Analyse the input once; every module reads the same results
+    { SCHLOMO_REALTIME_MODULE("Vocal Analysis");         analysis.process(context.getInputBlock(), renderPosition); }
 
     // Process through all enabled modules in sequence
     // Category 1: Human Vocal Randomizers
-    pitchDriftBrain.process(buffer);
-    formantWhispers.process(buffer);
-    breathNoiseEngine.process(buffer);
-    timingWobble.process(buffer);
-    volumePersonality.process(buffer);
-
-    // Category 2: Environmental / Bathtub
-    porcelainReflections.process(buffer);
-    steamModulator.process(buffer);
+    { SCHLOMO_REALTIME_MODULE("Pitch Drift Brain");      pitchDriftBrain.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Formant Whispers");       formantWhispers.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Breath & Noise Engine");  breathNoiseEngine.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Timing Wobble");          timingWobble.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Volume Personality");     volumePersonality.process(context); }
+
+    // Category 4: doubles are built from the humanised lead, before the room
+    { SCHLOMO_REALTIME_MODULE("Voice Identity Builder"); voiceIdentityBuilder.process(context); }
+
+    // Category 2: Environmental / Bathtub (the plumbing runs before the room reflects it)
+    { SCHLOMO_REALTIME_MODULE("Faucet Flutter");         faucetFlutter.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Drain Resonator");        drainResonator.process(context); }
+    porcelainReflections.setSteamHumidity(steamModulator.isEnabled() ? steamModulator.getHumidity() : 0.0f);
+    { SCHLOMO_REALTIME_MODULE("Porcelain Reflections");  porcelainReflections.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Steam Modulator");        steamModulator.process(context); }
 
     // Category 3: Character Modes
-    rubberDuckFM.process(buffer);
-    soapBarGlitch.process(buffer);
+    { SCHLOMO_REALTIME_MODULE("Rubber Duck FM");         rubberDuckFM.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Soap Bar Glitch");        soapBarGlitch.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Bathroom Fan Chorus");    bathroomFanChorus.process(context); }
+    { SCHLOMO_REALTIME_MODULE("Mildewy Wall Filter");    mildewyWallFilter.process(context); }
 
     // Master wet/dry mix
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    SCHLOMO_REALTIME_MODULE("Master Mix");
+
+    const int dryChannels = juce::jmin((int)block.getNumChannels(), (int)dry.getNumChannels());
+    const int drySamples = juce::jmin(numSamples, (int)dry.getNumSamples());
+
+    for (int channel = 0; channel < dryChannels; ++channel)
     {
-        auto* wetData = buffer.getWritePointer(channel);
-        const auto* dryData = dryBuffer.getReadPointer(channel);
+        auto* wetData = block.getChannelPointer((size_t)channel);
+        const auto* dryData = dry.getChannelPointer((size_t)channel);
 
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (int sample = 0; sample < drySamples; ++sample)
         {
             wetData[sample] = dryData[sample] * (1.0f - masterMix) + wetData[sample] * masterMix;
         }
     }
+
+    renderPosition += (juce::uint64)numSamples;
 }
 
 void VocalProcessor::reset()
 {
+    analysis.reset();
     pitchDriftBrain.reset();
     formantWhispers.reset();
     breathNoiseEngine.reset();
@@ -896,6 +2331,12 @@ void VocalProcessor::reset()
     volumePersonality.reset();
     porcelainReflections.reset();
     steamModulator.reset();
+    faucetFlutter.reset();
+    drainResonator.reset();
     rubberDuckFM.reset();
     soapBarGlitch.reset();
+    bathroomFanChorus.reset();
+    mildewyWallFilter.reset();
+    voiceIdentityBuilder.reset();
+    renderPosition = 0;
 }
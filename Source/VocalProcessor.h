@@ -1,8 +1,26 @@
 #pragma once
-#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 #include <rubberband/RubberBandLiveShifter.h>
+#include <atomic>
 #include <memory>
+#include "LazyModuleState.h"
+#include "RealtimeSafety.h"
+#include "PartitionedConvolution.h"
+#include "SeededRandom.h"
+#include "VocalAnalysis.h"
+
+//==============================================================================
+// Engine-wide processing quality. Eco is for tracking sessions with many
+// instances, High for the final mix and offline bounces. High adds four
+// second-order reflection taps, a finer control interval, Hermite fan-chorus
+// taps and (at the next prepare) the medium shifter window; no tier oversamples.
+enum class ProcessingQuality
+{
+    Eco,
+    Standard,
+    High
+};
 
 //==============================================================================
 // Base class for all vocal processing modules
@@ -15,14 +33,38 @@ public:
     // Prepare the module for processing
     virtual void prepare(double sampleRate, int samplesPerBlock) = 0;
 
-    // Process audio in-place
-    virtual void process(juce::AudioBuffer<float>& buffer) = 0;
+    // Process audio in place, or from a separate input block into an output
+    // block of the same size. Both are non-owning views, so they can be slices,
+    // channel subsets or oversampled blocks of the caller's audio.
+    void process(const juce::dsp::ProcessContextReplacing<float>& context)
+    {
+        if (! context.isBypassed)
+            processBlock(context.getOutputBlock());
+    }
+
+    void process(const juce::dsp::ProcessContextNonReplacing<float>& context)
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        jassert(inputBlock.getNumChannels() == outputBlock.getNumChannels()
+                && inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        // Modules mix against the input they read, so they run in place on the copy
+        outputBlock.copyFrom(inputBlock);
+
+        if (! context.isBypassed)
+            processBlock(outputBlock);
+    }
 
     // Reset internal state
     virtual void reset() = 0;
 
     // Module enable/disable
-    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    void setEnabled(bool shouldBeEnabled)
+    {
+        enabled = shouldBeEnabled;
+        activityChanged();
+    }
     bool isEnabled() const { return enabled; }
 
     // Wet/dry mix (0.0 = dry, 1.0 = wet)
@@ -32,16 +74,103 @@ public:
     // Module name for UI
     virtual juce::String getName() const = 0;
 
+    // Deterministic randomness: one stream per channel derived from the global seed
+    void setRandomSeed(juce::uint64 globalSeed, juce::uint32 moduleId)
+    {
+        for (int ch = 0; ch < maxRandomChannels; ++ch)
+            randomStreams[ch].setSeed(globalSeed, moduleId, (juce::uint32)ch);
+    }
+
+    // Absolute render position of the first sample passed to the next process() call
+    void setBlockStartSample(juce::uint64 position) { blockStartSample = position; }
+
+    // Shared analysis of the block's input, computed once by VocalProcessor
+    void setAnalysis(const VocalAnalysis* sharedAnalysis) { analysis = sharedAnalysis; }
+
+    // Quality tier. Only the shifter window waits for the next prepare(); everything
+    // else switches at once without allocating, so this is safe on the audio thread.
+    void setQuality(ProcessingQuality newQuality)
+    {
+        quality = newQuality;
+        qualityChanged();
+    }
+    ProcessingQuality getQuality() const { return quality; }
+
 protected:
+    // The module's DSP, in place on one block
+    virtual void processBlock(const juce::dsp::AudioBlock<float>& block) = 0;
+
+    SeededRandom& getRandom(int channel) { return randomStreams[juce::jlimit(0, maxRandomChannels - 1, channel)]; }
+
+    // Onsets detected in the current block (empty when running without VocalProcessor)
+    const OnsetEventList& getOnsets() const
+    {
+        static const OnsetEventList noOnsets;
+        return analysis != nullptr ? analysis->getOnsets() : noOnsets;
+    }
+
+    // Applies the current tier to already-allocated state; must not allocate
+    virtual void qualityChanged() {}
+
+    // Called by setters that can switch the module on (never on the audio
+    // thread); modules with lazily built state build it here
+    virtual void activityChanged() {}
+
+    // Control-rate period for the current tier: Eco halves the control rate, High doubles it
+    static constexpr int maxControlInterval = 64;
+    int getControlInterval() const
+    {
+        return quality == ProcessingQuality::Eco ? maxControlInterval : quality == ProcessingQuality::High ? 16 : 32;
+    }
+
     bool enabled = false;  // Disabled by default
     float mix = 1.0f;
     double currentSampleRate = 44100.0;
     int currentBlockSize = 512;
+    juce::uint64 blockStartSample = 0;
+    const VocalAnalysis* analysis = nullptr;  // Never null once owned by VocalProcessor
+    ProcessingQuality quality = ProcessingQuality::Standard;
+
+private:
+    static constexpr int maxRandomChannels = 2;
+    SeededRandom randomStreams[maxRandomChannels];
 };
 
 //==============================================================================
 // MODULE CATEGORY 1: Human Vocal Randomizers
 
+//==============================================================================
+// Shifter Bank
+// Heavy state shared by the RubberBand modules: one live shifter per side,
+// with its block buffers and output FIFO. Both sides are always built so Eco
+// (one shifter on the mid signal) can switch to High without allocating.
+// Built off the audio thread through LazyModuleState.
+struct ShifterBank
+{
+    static constexpr int numChannels = 2;
+
+    ShifterBank(double sampleRate, RubberBand::RubberBandLiveShifter::Options options);
+
+    // Input-to-output delay of a bank built with these settings: the block
+    // buffering plus the shifter's start delay. Allocates, so never on the audio thread.
+    static int getLatencySamples(double sampleRate, RubberBand::RubberBandLiveShifter::Options options);
+
+    void reset();
+    void resetChannel(int channel);  // Shifter and FIFO only (after sitting idle in Eco)
+
+    // Block-buffers one channel through its shifter, in place
+    void process(int channel, float* channelData, int numSamples);
+
+    std::unique_ptr<RubberBand::RubberBandLiveShifter> shifters[numChannels];
+    std::vector<float> inputBuffers[numChannels];
+    std::vector<float> outputBuffers[numChannels];
+    std::vector<float> outputFIFOs[numChannels];  // FIFO for output samples
+    size_t inputPos[numChannels] {};         // Write position in input buffer
+    size_t outputPos[numChannels] {};        // Read position in output FIFO
+    size_t outputAvailable[numChannels] {};  // Samples available in output FIFO
+    size_t rbBlockSize = 0;
+};
+
 //==============================================================================
 // 1. Pitch Drift Brain™
 // Behavior-driven pitch variation with vowel-based glides and searching
@@ -51,7 +180,6 @@ public:
     PitchDriftBrain();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Pitch Drift Brain"; }
 
@@ -64,8 +192,8 @@ public:
         AnxietyMode
     };
 
-    void setCentsLow(float cents) { centsLow = juce::jlimit(-150.0f, 0.0f, cents); }
-    void setCentsHigh(float cents) { centsHigh = juce::jlimit(0.0f, 150.0f, cents); }
+    void setCentsLow(float cents) { centsLow = juce::jlimit(-150.0f, 0.0f, cents); activityChanged(); }
+    void setCentsHigh(float cents) { centsHigh = juce::jlimit(0.0f, 150.0f, cents); activityChanged(); }
     void setLFOSpeed(float speed) { lfoSpeed = juce::jlimit(0.0f, 1.0f, speed); }
     void setRandomizeMode(bool randomize) { randomizeMode = randomize; }
 
@@ -77,7 +205,20 @@ public:
     float getCentsHigh() const { return centsHigh; }
     bool isRandomizeMode() const { return randomizeMode; }
 
+    // Pitch the singer is holding, from the shared pitch tracker (0 = none yet)
+    float getHeldPitchHz() const { return heldPitchHz; }
+    float getPitchConfidence() const { return pitchConfidence; }
+
+    // Delay the shifters add while shifting, fixed by the window chosen in prepare()
+    int getLatencySamples() const { return shifterLatency; }
+
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+    void qualityChanged() override;
+    void updateHeldPitch();
+    bool isActive() const { return enabled && (centsLow < 0.0f || centsHigh > 0.0f); }
+    void activityChanged() override { if (isActive()) shifterBank.build(); }
+
     float centsLow = 0.0f;   // -50 to 0 (flat range)
     float centsHigh = 0.0f;  // 0 to +50 (sharp range)
     float lfoSpeed = 0.3f;   // LFO speed (0.1 Hz to 5 Hz)
@@ -93,18 +234,17 @@ private:
     float targetCents = 0.0f;    // Target detuning at next peak/valley
     float previousCents = 0.0f;  // Previous target (for interpolation)
 
-    // RubberBand pitch shifter (one per channel for stereo)
-    std::vector<std::unique_ptr<RubberBand::RubberBandLiveShifter>> shifters;
-    std::vector<std::vector<float>> inputBuffers;
-    std::vector<std::vector<float>> outputBuffers;
-    std::vector<std::vector<float>> outputFIFOs;  // FIFO for output samples
-    std::vector<size_t> inputPos;   // Write position in input buffer
-    std::vector<size_t> outputPos;  // Read position in output FIFO
-    std::vector<size_t> outputAvailable;  // Samples available in output FIFO
-    size_t rbBlockSize = 0;
-    int numChannels = 0;
+    // Detected pitch state (feeds the behavior modes)
+    float heldPitchHz = 0.0f;
+    float pitchConfidence = 0.0f;
+
+    // RubberBand pitch shifters, only allocated while a range is set
+    LazyModuleState<ShifterBank> shifterBank;
+    double shifterSampleRate = 0.0;  // Rate the shifters were built for; prepare() rebuilds only on change
+    RubberBand::RubberBandLiveShifter::Options shifterOptions = 0;
+    int shifterLatency = 0;          // ShifterBank::getLatencySamples() for the prepared window
+    int activeChannels = 0;          // Eco shares one shifter across the mid signal
 
-    juce::Random random;
 };
 
 //==============================================================================
@@ -116,12 +256,11 @@ public:
     FormantWhispers();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Formant Whispers"; }
 
-    void setFormantShiftLow(float shift) { formantShiftLow = juce::jlimit(-5.0f, 0.0f, shift); }
-    void setFormantShiftHigh(float shift) { formantShiftHigh = juce::jlimit(0.0f, 5.0f, shift); }
+    void setFormantShiftLow(float shift) { formantShiftLow = juce::jlimit(-5.0f, 0.0f, shift); activityChanged(); }
+    void setFormantShiftHigh(float shift) { formantShiftHigh = juce::jlimit(0.0f, 5.0f, shift); activityChanged(); }
     void setFormantLFOSpeed(float speed) { formantLFOSpeed = juce::jlimit(0.0f, 1.0f, speed); }
     void setFormantRandomizeMode(bool randomize) { formantRandomizeMode = randomize; }
 
@@ -132,7 +271,15 @@ public:
     float getFormantShiftHigh() const { return formantShiftHigh; }
     bool isFormantRandomizeMode() const { return formantRandomizeMode; }
 
+    // Delay the shifters add while shifting, fixed by the window chosen in prepare()
+    int getLatencySamples() const { return shifterLatency; }
+
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+    void qualityChanged() override;
+    bool isActive() const { return enabled && (formantShiftLow < 0.0f || formantShiftHigh > 0.0f); }
+    void activityChanged() override { if (isActive()) shifterBank.build(); }
+
     // LFO-based formant shifting
     float formantShiftLow = 0.0f;    // -1.0 to 0 (shift down)
     float formantShiftHigh = 0.0f;   // 0 to 1.0 (shift up)
@@ -146,18 +293,13 @@ private:
     float targetFormantShift = 0.0f;
     float previousFormantShift = 0.0f;
 
-    // RubberBand for formant shifting (one per channel)
-    std::vector<std::unique_ptr<RubberBand::RubberBandLiveShifter>> shifters;
-    std::vector<std::vector<float>> inputBuffers;
-    std::vector<std::vector<float>> outputBuffers;
-    std::vector<std::vector<float>> outputFIFOs;
-    std::vector<size_t> inputPos;
-    std::vector<size_t> outputPos;
-    std::vector<size_t> outputAvailable;
-    size_t rbBlockSize = 0;
-    int numChannels = 0;
+    // RubberBand for formant shifting, only allocated while a range is set
+    LazyModuleState<ShifterBank> shifterBank;
+    double shifterSampleRate = 0.0;  // Rate the shifters were built for; prepare() rebuilds only on change
+    RubberBand::RubberBandLiveShifter::Options shifterOptions = 0;
+    int shifterLatency = 0;          // ShifterBank::getLatencySamples() for the prepared window
+    int activeChannels = 0;          // Eco shares one shifter across the mid signal
 
-    juce::Random random;
 };
 
 //==============================================================================
@@ -169,7 +311,6 @@ public:
     BreathNoiseEngine();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Breath & Noise Engine"; }
 
@@ -177,12 +318,12 @@ public:
     void setHuffMode(bool enabled) { huffMode = enabled; }
 
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
     float breathIntensity = 0.0f;
     bool huffMode = false;
 
-    juce::Random random;
     juce::dsp::IIR::Filter<float> breathFilter;
-    float envelopeFollower = 0.0f;
 };
 
 //==============================================================================
@@ -194,19 +335,21 @@ public:
     TimingWobble();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Timing Wobble"; }
 
-    void setWobbleAmount(float amount) { wobbleAmount = juce::jlimit(0.0f, 1.0f, amount); }
+    void setWobbleAmount(float amount) { wobbleAmount = juce::jlimit(0.0f, 1.0f, amount); activityChanged(); }
     void setSwingFeel(float swing) { swingFeel = juce::jlimit(0.0f, 1.0f, swing); }
 
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+    bool isActive() const { return enabled && wobbleAmount > 0.0f; }
+    void activityChanged() override { if (isActive()) timingBuffer.build(); }
+
     float wobbleAmount = 0.0f;
     float swingFeel = 0.0f;
 
-    juce::dsp::DelayLine<float> timingBuffer{44100};
-    juce::Random random;
+    LazyModuleState<juce::dsp::DelayLine<float>> timingBuffer;  // 44100 samples, only while wobbling
     float currentDelay = 0.0f;
 };
 
@@ -219,7 +362,6 @@ public:
     VolumePersonality();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Volume Personality"; }
 
@@ -234,10 +376,11 @@ public:
     void setIntensity(float intensity) { this->intensity = juce::jlimit(0.0f, 1.0f, intensity); }
 
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
     PersonalityType personalityType = Wavering;
     float intensity = 0.0f;
 
-    juce::Random random;
     float currentGain = 1.0f;
     float targetGain = 1.0f;
 };
@@ -245,6 +388,71 @@ private:
 //==============================================================================
 // MODULE CATEGORY 2: Environmental / Bathtub Randomizers
 
+//==============================================================================
+// Late reverb behind Porcelain Reflections
+// 8-line feedback delay network. The lines live in one power-of-two buffer,
+// their state in aligned 8-float arrays. Damping, feedback gain and the
+// Hadamard mix run on two 4-lane juce::dsp::SIMDRegisters (lines 0-3 and 4-7):
+// H8 = H2 x H4, so the first butterfly stage is a sum and a difference of the
+// two registers and the other two are a 4x4 Hadamard applied within each one
+// as broadcast multiply-adds (SIMDRegister has no lane shuffles). The modulated
+// reads and the writes back into the lines stay scalar gathers and scatters.
+// Read taps drift slowly to break up metallic modes; per-line lowpass damping
+// follows the steam in the room.
+class FeedbackDelayNetwork
+{
+public:
+    static constexpr int numLines = 8;
+
+    void prepare(double sampleRate, int controlIntervalToUse);
+    void reset();
+
+    // Allocation-free; the new rate starts at the next control tick
+    void setControlInterval(int samples) { controlInterval = samples; }
+
+    void setDecayTime(float seconds) { decaySeconds = juce::jlimit(0.1f, 10.0f, seconds); }
+    void setHumidity(float amount) { humidity = juce::jlimit(0.0f, 1.0f, amount); }
+
+    // Stereo in (the reflection taps), stereo out; output buffers are overwritten
+    void process(const float* inputLeft, const float* inputRight, float* outputLeft, float* outputRight, int numSamples);
+
+private:
+    void updateControl();
+
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = 4;
+    static_assert(Lanes::SIMDNumElements == lanes && numLines == 2 * lanes, "The mix assumes two 4-lane registers");
+
+    double currentSampleRate = 44100.0;
+    int controlInterval = 32;
+    float decaySeconds = 0.8f;
+    float humidity = 0.0f;
+
+    std::vector<float> lines;   // numLines * lineSize
+    int lineSize = 0;
+    int lineMask = 0;
+    int writePosition = 0;
+
+    alignas(32) float baseDelay[numLines] {};
+    alignas(32) float tapDelay[numLines] {};     // Current read delay, in samples
+    alignas(32) float delayStep[numLines] {};    // Per-sample glide to the next control tick
+    alignas(32) float feedbackGain[numLines] {};
+    alignas(32) float dampState[numLines] {};
+    float dampCoeff = 1.0f;
+
+    // 4x4 Hadamard columns with the whole matrix's 1/sqrt(8) folded in
+    alignas(16) float hadamardColumns[lanes][lanes] {};
+
+    float modulationPhase[numLines] {};
+    float modulationIncrement[numLines] {};  // Radians per sample
+    float modulationDepth = 0.0f;
+    int samplesToControl = 0;
+
+    // Coefficients are only recomputed when these change
+    float gainsForDecay = -1.0f;
+    float dampingForHumidity = -1.0f;
+};
+
 //==============================================================================
 // 6. Porcelain Reflections Engine
 // Chaotic early reflections, not static reverb
@@ -254,21 +462,53 @@ public:
     PorcelainReflections();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Porcelain Reflections"; }
 
     void setTileScatter(float amount) { tileScatter = juce::jlimit(0.0f, 1.0f, amount); }
     void setEdgeSlap(float amount) { edgeSlap = juce::jlimit(0.0f, 1.0f, amount); }
 
+    // Late reverb fed by the reflection taps
+    void setLateLevel(float level) { lateLevel = juce::jlimit(0.0f, 1.0f, level); }
+    void setTailLength(float seconds) { lateReverb.setDecayTime(seconds); }
+
+    // Steam in the room darkens the tail (set by VocalProcessor from SteamModulator)
+    void setSteamHumidity(float amount) { lateReverb.setHumidity(amount); }
+
+    // Real tub mode: convolve with a loaded bathroom IR instead of the taps
+    void setConvolutionMode(bool enabled) { convolutionMode = enabled; }
+    bool isConvolutionMode() const { return convolutionMode; }
+
+    // Message thread; the IR is loaded in the background and swapped in when ready
+    void loadImpulseResponse(const juce::File& file) { convolution.loadImpulseResponse(file); }
+    const juce::File& getImpulseResponseFile() const { return convolution.getImpulseResponseFile(); }
+
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+    void qualityChanged() override;
+    void processConvolution(const juce::dsp::AudioBlock<float>& block);
+
     float tileScatter = 0.0f;
     float edgeSlap = 0.0f;
 
-    // Multiple delay lines for reflections
-    static constexpr int NUM_REFLECTIONS = 8;
+    // Multiple delay lines for reflections. Every line is written at every tier,
+    // so a tier switch never replays stale audio; only the reads are skipped.
+    static constexpr int NUM_REFLECTIONS = 12;
+    static constexpr int standardReflections = 8;    // Eco reads half of these, High all twelve
+    static constexpr double maxReflectionMs = 64.0;  // Furthest tap (56.7 ms) plus scatter
+    int numActiveReflections = standardReflections;
     juce::dsp::DelayLine<float> reflections[NUM_REFLECTIONS];
-    juce::Random random;
+
+    // Late reverb
+    float lateLevel = 0.0f;
+    FeedbackDelayNetwork lateReverb;
+    juce::AudioBuffer<float> tapWet;
+    juce::AudioBuffer<float> lateWet;
+
+    // Convolution mode
+    bool convolutionMode = false;
+    ConvolutionReverb convolution;
+    juce::AudioBuffer<float> convolutionWet;
 };
 
 //==============================================================================
@@ -280,22 +520,157 @@ public:
     SteamModulator();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Steam Modulator"; }
 
     void setHumidity(float amount) { humidity = juce::jlimit(0.0f, 1.0f, amount); }
+    float getHumidity() const { return humidity; }
     void setFogMode(bool enabled) { fogMode = enabled; }
 
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
     float humidity = 0.0f;
     bool fogMode = false;
 
     juce::dsp::IIR::Filter<float> highFreqDamper;
-    juce::Random random;
     float steamIntensity = 0.0f;
 };
 
+//==============================================================================
+// 8. Faucet Flutter
+// Water pressure -> modulation. The tremolo and the drunk "hydro-LFO" are
+// evaluated once per controlInterval and applied as gain ramps, and drips
+// (noisy onsets, plus the odd random one) flick the pitch through a short
+// modulated read tap. The cold-water comb reads a power-of-two masked ring
+// with its delay and feedback held constant across each control block.
+class FaucetFlutter : public VocalModule
+{
+public:
+    FaucetFlutter();
+
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    juce::String getName() const override { return "Faucet Flutter"; }
+
+    void setWaterPressure(float amount) { waterPressure = juce::jlimit(0.0f, 1.0f, amount); }
+    void setColdWater(float amount) { coldWater = juce::jlimit(0.0f, 1.0f, amount); }
+    void setDripAmount(float amount) { dripAmount = juce::jlimit(0.0f, 1.0f, amount); }
+
+private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
+    static constexpr int maxChannels = 2;
+    int controlInterval = 32;  // Follows the quality tier
+
+    void qualityChanged() override { controlInterval = getControlInterval(); }
+    void updateControl(juce::uint64 position);
+    void triggerDrip(float strength, SeededRandom& rng);
+
+    float waterPressure = 0.0f;   // Tremolo depth and flutter speed
+    float coldWater = 0.3f;       // Metallic comb resonance
+    float dripAmount = 0.5f;      // Pitch flick depth and drip rate
+
+    // Hydro-LFO: a phase whose rate and shape wander like a drunk walk
+    float hydroPhase = 0.0f;
+    float hydroRate = 6.0f;       // Hz
+    float hydroShape = 1.0f;      // Waveshaper drive, higher = choppier
+    float tremoloGain = 1.0f;     // Gain at the end of the previous control block
+
+    // Drips: a short rise-and-fall of the read-tap delay bends the pitch down and back
+    float flickPosition = 1.0f;   // 0..1 through the flick, 1 = idle
+    float flickIncrement = 0.0f;
+    float flickDepthSamples = 0.0f;
+    float flickDelay = 0.0f;      // Tap delay at the end of the previous control block
+
+    // Power-of-two rings: input history for the tap, comb output for feedback
+    std::vector<float> inputRing;     // maxChannels * ringSize
+    std::vector<float> combRing;      // maxChannels * ringSize
+    int ringSize = 0;
+    int ringMask = 0;
+    int writePosition = 0;
+
+    int combDelay = 24;               // Samples, ~1.5-3 kHz
+    float combFeedback = 0.0f;
+    float combDamping[maxChannels] {};
+    float maxFlickSamples = 0.0f;
+};
+
+//==============================================================================
+// 9. Drain Resonator
+// Tonal whines beneath the voice from a bank of constant-peak bandpass
+// resonators. The bank is stored struct-of-arrays and run with
+// juce::dsp::SIMDRegister, one register of filters per step (4 on SSE and
+// NEON); the weighted outputs accumulate lane-wise and are summed with a
+// single horizontal add per sample, since a float reduction would stay scalar
+// without -ffast-math. Loud syllables retune a few peaks to random 200-800 Hz
+// pipe resonances; all tuning, flutter and decay runs at control rate, every
+// controlInterval samples.
+class DrainResonator : public VocalModule
+{
+public:
+    DrainResonator();
+
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    juce::String getName() const override { return "Drain Resonator"; }
+
+    void setResonance(float amount) { resonance = juce::jlimit(0.0f, 1.0f, amount); }
+    void setHumLevel(float level) { humLevel = juce::jlimit(0.0f, 1.0f, level); }
+    void setHumFrequency(float hz) { humFrequency = juce::jlimit(50.0f, 200.0f, hz); }
+    void setClogMode(bool enabled) { clogMode = enabled; }
+
+    static constexpr int numResonators = 16;   // Multiple of the SIMD width so the bank loop has no tail
+    static constexpr int numHumResonators = 2; // Hum fundamental + 2nd harmonic
+
+private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
+    static constexpr int maxChannels = 2;
+    int controlInterval = 32;  // Follows the quality tier
+
+    void qualityChanged() override;
+    void updateControl(float level, juce::uint64 position);
+    void retunePeak(int index, float strength, SeededRandom& rng);
+
+    float resonance = 0.0f;
+    float humLevel = 0.0f;
+    float humFrequency = 60.0f;
+    bool clogMode = false;
+
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static_assert(numResonators % Lanes::SIMDNumElements == 0, "The bank must fill whole registers");
+
+    // Coefficients and gains, shared by both channels: y = b0 (x - x2) + a1 y1 - a2 y2
+    alignas(32) float b0[numResonators] {};
+    alignas(32) float a1[numResonators] {};
+    alignas(32) float a2[numResonators] {};
+    alignas(32) float gain[numResonators] {};
+    alignas(32) float gainStep[numResonators] {};  // Per-sample ramp to the next control tick
+
+    // Filter state per channel
+    alignas(32) float y1[maxChannels][numResonators] {};
+    alignas(32) float y2[maxChannels][numResonators] {};
+    float x1[maxChannels] {};
+    float x2[maxChannels] {};
+
+    // Control-rate tuning per resonator
+    float targetFrequency[numResonators] {};
+    float currentFrequency[numResonators] {};
+    float resonanceQ[numResonators] {};
+    float peakLevel[numResonators] {};
+    float flutterPhase[numResonators] {};
+    float flutterRate[numResonators] {};
+
+    float peakDecay = 0.0f;        // Per control tick
+    float glideCoeff = 0.0f;       // Per control tick
+    float clogLowpassCoeff = 0.0f; // Per sample
+    float clogState[maxChannels] {};
+    float clogGurgle = 1.0f;
+    bool triggerArmed = true;
+    int nextPeak = numHumResonators;
+};
+
 //==============================================================================
 // MODULE CATEGORY 3: Funny / Chaotic / Character Modes
 
@@ -308,7 +683,6 @@ public:
     RubberDuckFM();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Rubber Duck FM"; }
 
@@ -323,11 +697,16 @@ public:
     void setQuackIntensity(float intensity) { quackIntensity = juce::jlimit(0.0f, 1.0f, intensity); }
 
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
     QuackMode quackMode = WetQuack;
     float quackIntensity = 0.0f;
 
     float fmPhase = 0.0f;
-    juce::Random random;
+
+    // Quack bursts triggered by onsets (one envelope per channel)
+    float quackEnvelope[2] {};
+    float quackDecay = 0.0f;
 };
 
 //==============================================================================
@@ -339,19 +718,240 @@ public:
     SoapBarGlitch();
 
     void prepare(double sampleRate, int samplesPerBlock) override;
-    void process(juce::AudioBuffer<float>& buffer) override;
     void reset() override;
     juce::String getName() const override { return "Soap Bar Glitch"; }
 
-    void setSlipperiness(float amount) { slipperiness = juce::jlimit(0.0f, 1.0f, amount); }
+    void setSlipperiness(float amount) { slipperiness = juce::jlimit(0.0f, 1.0f, amount); activityChanged(); }
     void setSoapyBlur(float amount) { soapyBlur = juce::jlimit(0.0f, 1.0f, amount); }
 
 private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+    bool isActive() const { return enabled && slipperiness > 0.0f; }
+    void activityChanged() override { if (isActive()) grainBuffer.build(); }
+
     float slipperiness = 0.0f;
     float soapyBlur = 0.0f;
 
-    juce::dsp::DelayLine<float> grainBuffer{88200};
-    juce::Random random;
+    LazyModuleState<juce::dsp::DelayLine<float>> grainBuffer;  // 88200 samples, only while slipping
+
+    // Grain state
+    float grainPhase = 0.0f;
+    float slipAmount = 0.0f;
+    float targetSlip = 0.0f;
+    int grainSize = 512;
+};
+
+//==============================================================================
+// 12. Bathroom Fan Chorus
+// A vibrating, slightly broken fan blender. Every voice is an interpolated
+// tap into one shared delay ring per channel, so voices only cost state, not
+// memory. The rotor (RPM wobble, blade-spaced tap modulation, noise jitter)
+// runs at control rate; broken-fan sputters are gain events applied to the
+// wet signal one control block at a time.
+class BathroomFanChorus : public VocalModule
+{
+public:
+    BathroomFanChorus();
+
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    juce::String getName() const override { return "Bathroom Fan Chorus"; }
+
+    static constexpr int maxVoices = 16;
+
+    void setFanAmount(float amount) { fanAmount = juce::jlimit(0.0f, 1.0f, amount); }
+    void setFanSpeed(float speed) { fanSpeed = juce::jlimit(0.0f, 1.0f, speed); }
+    void setNumVoices(int voices) { numVoices = juce::jlimit(1, maxVoices, voices); }
+    void setBrokenFan(bool broken) { brokenFan = broken; }
+
+private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
+    static constexpr int maxChannels = 2;
+    int controlInterval = 32;        // Follows the quality tier
+    bool cubicTaps = false;          // High: 4-point Hermite tap reads instead of linear
+
+    void qualityChanged() override;
+    void updateControl(juce::uint64 position);
+
+    float fanAmount = 0.0f;
+    float fanSpeed = 0.5f;     // RPM: rotor rate and HF shimmer
+    int numVoices = 4;
+    bool brokenFan = false;
+
+    // Rotor
+    float rotorPhase = 0.0f;
+    float rpmDrift = 0.0f;
+
+    // Per-voice tap delays in samples (previous and current control tick)
+    float previousDelay[maxVoices] {};
+    float currentDelay[maxVoices] {};
+    float jitter[maxVoices] {};
+
+    // Sputter events and shimmer, as control-rate gains
+    float wetGain = 1.0f;
+    int sputterTicksLeft = 0;
+    float sputterDepth = 1.0f;
+    float shimmerGain = 0.0f;
+    float shimmerState[maxChannels] {};
+
+    // Shared power-of-two delay ring per channel
+    std::vector<float> ring;   // maxChannels * ringSize
+    int ringSize = 0;
+    int ringMask = 0;
+    int writePosition = 0;
+
+    juce::AudioBuffer<float> wetBuffer;  // One control block of summed taps
+};
+
+//==============================================================================
+// 13. Mildewy Wall Filter
+// Slow, organic filtering from a cascade of TPT state-variable filters (HF
+// smother, mid dampening, damp low-mid resonance, moldburst spike). Targets
+// drift by random walk and are turned into coefficients once per
+// controlInterval - one tan() per stage - then interpolated per sample, which
+// the SVF tolerates without zipper noise or blow-ups. Moldbursts are a pure
+// function of the render position: every 64-sample slot rolls once.
+class MildewyWallFilter : public VocalModule
+{
+public:
+    MildewyWallFilter();
+
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    juce::String getName() const override { return "Mildewy Wall Filter"; }
+
+    void setMildew(float amount) { mildew = juce::jlimit(0.0f, 1.0f, amount); }
+    void setMoldburstRate(float rate) { moldburstRate = juce::jlimit(0.0f, 1.0f, rate); }
+
+private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
+    static constexpr int maxChannels = 2;
+    static constexpr juce::uint64 burstSlotSize = maxControlInterval;  // Same slots at every quality tier
+    int controlInterval = 32;  // Follows the quality tier
+
+    enum Stage { HighSmother, MidDamp, DampResonance, Moldburst, numStages };
+
+    // y = m0 x + m1 band + m2 low, with the SVF's a1..a3 precomputed
+    struct SvfCoefficients
+    {
+        float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+        float m0 = 1.0f, m1 = 0.0f, m2 = 0.0f;
+    };
+
+    void qualityChanged() override;
+    SvfCoefficients makeLowPass(float frequencyHz, float q) const;
+    SvfCoefficients makeBell(float frequencyHz, float q, float gainDb) const;
+
+    void rollMoldbursts(juce::uint64 position);
+    void updateControl(juce::uint64 position);
+
+    float mildew = 0.0f;
+    float moldburstRate = 0.5f;
+
+    // Slow random walks, 0..1
+    float smotherWalk = 0.5f;
+    float midFrequencyWalk = 0.5f;
+    float midDepthWalk = 0.5f;
+    float resonanceWalk = 0.5f;
+
+    // The spike currently sounding
+    float burstFrequency = 1000.0f;
+    float burstTarget = 0.0f;
+    float burstLevel = 0.0f;
+    float burstAttack = 0.0f;      // Per control tick
+    float burstDecay = 0.0f;       // Per control tick
+
+    SvfCoefficients previousCoeffs[numStages];
+    SvfCoefficients currentCoeffs[numStages];
+    float ic1[maxChannels][numStages] {};
+    float ic2[maxChannels][numStages] {};
+};
+
+//==============================================================================
+// MODULE CATEGORY 4: Macro Behavior Engine
+
+//==============================================================================
+// 17. Voice Identity Builder
+// Pitch-synchronous doubler: every voice is resynthesised with windowed grains
+// from one shared input history, spaced by the shared pitch tracker's period.
+// Grain playback rate moves the formants, grain spacing sets pitch/vibrato,
+// so each extra voice costs a few interpolated reads per sample.
+class VoiceIdentityBuilder : public VocalModule
+{
+public:
+    VoiceIdentityBuilder();
+
+    void prepare(double sampleRate, int samplesPerBlock) override;
+    void reset() override;
+    juce::String getName() const override { return "Voice Identity Builder"; }
+
+    static constexpr int maxVoices = 8;
+
+    // One "This Voice" character
+    struct VoiceIdentity
+    {
+        float formantScale = 1.0f;    // Grain playback rate, 0.8 (bigger) .. 1.25 (smaller)
+        float timingMs = 15.0f;       // How far the double lags the lead
+        float vibratoRateHz = 5.0f;
+        float vibratoCents = 10.0f;
+        float detuneCents = 0.0f;
+        float brightness = 0.0f;      // -1 dark .. +1 bright
+        float pan = 0.0f;             // -1 left .. +1 right
+    };
+
+    void setNumVoices(int voices) { numVoices = juce::jlimit(0, maxVoices, voices); }
+    void setDoubleLevel(float level) { doubleLevel = juce::jlimit(0.0f, 1.0f, level); }
+    int getNumVoices() const { return numVoices; }
+
+    // Roll a consistent set of identities; the same seed always gives the same voices
+    void randomizeIdentities(juce::uint32 newIdentitySeed);
+    juce::uint32 getIdentitySeed() const { return identitySeed; }
+
+    void setIdentity(int voice, const VoiceIdentity& identity);
+    const VoiceIdentity& getIdentity(int voice) const { return identities[juce::jlimit(0, maxVoices - 1, voice)]; }
+
+private:
+    void processBlock(const juce::dsp::AudioBlock<float>& block) override;
+
+    static constexpr int maxGrainsPerVoice = 4;
+    static constexpr int windowTableSize = 1024;
+
+    struct Grain
+    {
+        float readPosition = 0.0f;    // Into the history ring
+        float readIncrement = 1.0f;
+        float windowPosition = 0.0f;  // 0..1 through the Hann window
+        float windowIncrement = 0.0f;
+        bool active = false;
+    };
+
+    struct VoiceState
+    {
+        Grain grains[maxGrainsPerVoice];
+        float samplesToNextGrain = 0.0f;
+        float vibratoPhase = 0.0f;
+        float tiltState = 0.0f;
+        float gainLeft = 0.7071f;
+        float gainRight = 0.7071f;
+    };
+
+    void startGrain(VoiceState& voice, const VoiceIdentity& identity, float period);
+    float readHistory(float position) const;
+
+    int numVoices = 0;
+    float doubleLevel = 0.5f;
+    juce::uint32 identitySeed = 1;
+
+    VoiceIdentity identities[maxVoices];
+    VoiceState voices[maxVoices];
+
+    std::vector<float> history;       // Mono input ring, power-of-two sized
+    int historyMask = 0;
+    int writePosition = 0;
+    std::shared_ptr<const std::vector<float>> windowTable;  // windowTableSize + 1 points, shared process-wide
+    float tiltCoeff = 0.0f;
 };
 
 //==============================================================================
@@ -363,9 +963,20 @@ public:
     ~VocalProcessor() = default;
 
     void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer);
     void reset();
 
+    // Host entry point: processes the buffer in place
+    void process(juce::AudioBuffer<float>& buffer);
+
+    // The same on non-owning views. A non-replacing context renders the input
+    // into a separate output and mixes against the input, without a dry copy.
+    void process(const juce::dsp::ProcessContextReplacing<float>& context);
+    void process(const juce::dsp::ProcessContextNonReplacing<float>& context);
+
+    // Host buffers are cut into sub-blocks on this grid of the render timeline, so
+    // modules see the same blocks (and control updates) at any host buffer size
+    static constexpr int subBlockSize = 64;
+
     // Access modules
     PitchDriftBrain& getPitchDriftBrain() { return pitchDriftBrain; }
     FormantWhispers& getFormantWhispers() { return formantWhispers; }
@@ -374,14 +985,52 @@ public:
     VolumePersonality& getVolumePersonality() { return volumePersonality; }
     PorcelainReflections& getPorcelainReflections() { return porcelainReflections; }
     SteamModulator& getSteamModulator() { return steamModulator; }
+    FaucetFlutter& getFaucetFlutter() { return faucetFlutter; }
+    DrainResonator& getDrainResonator() { return drainResonator; }
     RubberDuckFM& getRubberDuckFM() { return rubberDuckFM; }
     SoapBarGlitch& getSoapBarGlitch() { return soapBarGlitch; }
+    BathroomFanChorus& getBathroomFanChorus() { return bathroomFanChorus; }
+    MildewyWallFilter& getMildewyWallFilter() { return mildewyWallFilter; }
+    VoiceIdentityBuilder& getVoiceIdentityBuilder() { return voiceIdentityBuilder; }
+    const VocalAnalysis& getAnalysis() const { return analysis; }
 
     // Master wet/dry
     void setMasterMix(float mix) { masterMix = juce::jlimit(0.0f, 1.0f, mix); }
     float getMasterMix() const { return masterMix; }
 
+    // Global random seed - every module/channel stream is derived from it
+    void setSeed(juce::uint64 newSeed);
+    juce::uint64 getSeed() const { return seed; }
+
+    // Absolute sample position of the next block (jump-ahead for split renders)
+    void setRenderPosition(juce::uint64 samplePosition) { renderPosition = samplePosition; }
+    juce::uint64 getRenderPosition() const { return renderPosition; }
+
+    // Quality tier chosen by the user. Safe from any thread: modules switch at the
+    // start of the next process() without allocating, the shifter window (and with
+    // it the latency) at the next prepare().
+    void setQuality(ProcessingQuality newQuality) { quality = newQuality; }
+    ProcessingQuality getQuality() const { return quality; }
+
+    // Delay the pitch and formant shifters add, for the window of the last prepare().
+    // Report it to the host after every prepare().
+    int getLatencySamples() const;
+
+    // Offline bounces run every module at High, except the shifter window, which
+    // stays as prepared so the latency reported to the host never changes.
+    // What a bounce gains is therefore latency-neutral: the four second-order
+    // reflection taps, a 16-sample control interval (smoother modulation, FDN
+    // and filter sweeps) and Hermite fan-chorus taps. Nothing is oversampled;
+    // the only audio-rate modulation (Rubber Duck FM) moves partials by 800 Hz
+    // at most, so little of it folds back.
+    // The switch happens at the start of the next process() without allocating.
+    void setOfflineRendering(bool isOffline) { offlineRendering = isOffline; }
+    bool isOfflineRendering() const { return offlineRendering; }
+
 private:
+    // Shared analysis stage (runs before every module)
+    VocalAnalysis analysis;
+
     // Category 1: Human Vocal Randomizers
     PitchDriftBrain pitchDriftBrain;
     FormantWhispers formantWhispers;
@@ -392,11 +1041,32 @@ private:
     // Category 2: Environmental / Bathtub Randomizers
     PorcelainReflections porcelainReflections;
     SteamModulator steamModulator;
+    FaucetFlutter faucetFlutter;
+    DrainResonator drainResonator;
 
     // Category 3: Funny / Chaotic / Character Modes
     RubberDuckFM rubberDuckFM;
     SoapBarGlitch soapBarGlitch;
+    BathroomFanChorus bathroomFanChorus;
+    MildewyWallFilter mildewyWallFilter;
+
+    // Category 4: Macro Behavior Engine
+    VoiceIdentityBuilder voiceIdentityBuilder;
 
     float masterMix = 0.5f;
-    juce::AudioBuffer<float> dryBuffer;
+    juce::AudioBuffer<float> dryBuffer;  // Dry copy of each sub-block when processing in place
+
+    // separateInput is null for in-place processing
+    void render(const juce::dsp::AudioBlock<float>& output, const juce::dsp::AudioBlock<const float>* separateInput, bool bypassed);
+    void processSubBlock(juce::dsp::AudioBlock<float> block, const juce::dsp::AudioBlock<const float>& dry);
+
+    // Deterministic randomness
+    std::vector<VocalModule*> modules;  // All modules; index + 1 is the random stream id, so only append
+    juce::uint64 seed = 0;
+    juce::uint64 renderPosition = 0;
+    std::atomic<ProcessingQuality> quality { ProcessingQuality::Standard };
+    ProcessingQuality appliedQuality = ProcessingQuality::Standard;  // What the modules are running
+    bool offlineRendering = false;
+
+    void applyQuality(ProcessingQuality newQuality);
 };
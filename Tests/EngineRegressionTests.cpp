@@ -0,0 +1,576 @@
+//==============================================================================
+// Engine Regression Tests
+// Renders a deterministic synthetic vocal through each VocalModule on its own,
+// all with a fixed seed, then
+//   golden:      compares a windowed fingerprint of the output against the
+//                reference stored in Tests/Golden/<case>.txt
+//   performance: fails when a case's ns/sample goes over its budget in
+//                Tests/Golden/budgets.txt
+//   realtime:    runs the full engine with the RealtimeSafety interceptors
+//                compiled in and fails on any allocation, free or blocking
+//                call inside a render (the SchlomoRealtimeTests build)
+// so engine rewrites cannot silently change the sound, make it slower or
+// make it unsafe on the audio thread.
+//
+//   cmake -B build -DSCHLOMO_BUILD_TESTS=ON -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build --target SchlomoEngineTests
+//   ctest --test-dir build --output-on-failure
+//
+//   SchlomoEngineTests <golden|performance> <referenceDir> [--update]
+//   SchlomoRealtimeTests realtime
+//
+// References are committed and only read: a missing one fails the test.
+// --update (re)writes them after an intentional change to the sound or cost,
+// always from a Release build with the bundled RubberBand linked. The shifter
+// modules and the full engine join the golden cases once theirs are recorded.
+//==============================================================================
+#include "VocalProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double twoPi = 6.283185307179586;
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 96000;             // 2 seconds
+    constexpr int hostBlockSize = 512;
+    constexpr int fingerprintOrder = 10;
+    constexpr int fingerprintWindow = 1 << fingerprintOrder;
+    constexpr double centroidGate = 1.0e-3;       // -60 dBFS mid RMS
+    constexpr juce::uint64 testSeed = 0x5C410B47;
+
+    // Fingerprint tolerance: |actual - reference| <= absolute + relative * |reference|
+    constexpr double absoluteTolerance = 1.0e-4;  // -80 dBFS
+    constexpr double relativeTolerance = 0.01;    // ~0.09 dB, or ~17 cents of centroid
+
+    // Budgets are recorded with this much headroom over the measured cost
+    constexpr double budgetHeadroom = 1.5;
+    constexpr int performanceRepeats = 5;
+
+    constexpr int exitPassed = 0;
+    constexpr int exitFailed = 1;
+    constexpr int exitSkipped = 77;  // Matches SKIP_RETURN_CODE in CMakeLists.txt
+    const char* const missingReference = "no reference; record it with --update";
+
+    using Fingerprint = std::vector<std::vector<double>>;
+
+    struct TestCase
+    {
+        std::string id;
+        std::function<void(VocalProcessor&)> configure;
+    };
+
+    //==========================================================================
+    // Deterministic synthetic vocal: sung syllables with glides, vibrato, two
+    // alternating vowels, consonant bursts at the onsets and a little breath.
+    // Uses its own LCG so the input never depends on the engine's random streams.
+    struct NoiseSource
+    {
+        juce::uint32 state;
+        float next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return (float)(state >> 8) / 8388608.0f - 1.0f;
+        }
+    };
+
+    juce::AudioBuffer<float> makeSyntheticVocal()
+    {
+        static constexpr double notes[] = { 220.0, 246.9, 261.6, 293.7, 261.6, 246.9 };
+        static constexpr double vowels[2][2] = { { 730.0, 1090.0 },    // "ah"
+                                                 { 270.0, 2290.0 } };  // "ee"
+        constexpr double syllableSeconds = 0.35;
+        constexpr double gapSeconds = 0.1;
+        constexpr double period = syllableSeconds + gapSeconds;
+
+        juce::AudioBuffer<float> signal(2, numSamples);
+        NoiseSource noise[2] { { 0x1234567u }, { 0x89ABCDEu } };
+        double phase = 0.0;
+        double f0 = notes[0];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = (double)i / sampleRate;
+            const int syllable = (int)(t / period);
+            const double inSyllable = t - syllable * period;
+            const bool voiced = inSyllable < syllableSeconds;
+
+            // Glide towards each new note, vibrato once the note has settled
+            const double target = notes[syllable % (int)std::size(notes)];
+            f0 += (target - f0) * 0.002;
+            const double vibrato = inSyllable > 0.15 ? 1.0 + 0.006 * std::sin(twoPi * 5.5 * t) : 1.0;
+            phase += twoPi * f0 * vibrato / sampleRate;
+
+            double voice = 0.0;
+            if (voiced)
+            {
+                const auto& formants = vowels[syllable % 2];
+                for (int harmonic = 1; harmonic <= 20; ++harmonic)
+                {
+                    const double frequency = f0 * harmonic;
+                    double weight = 0.0;
+                    for (double formant : formants)
+                        weight += std::exp(-0.5 * std::pow((frequency - formant) / 120.0, 2.0));
+
+                    voice += (0.15 + weight) * std::sin(phase * harmonic) / harmonic;
+                }
+
+                const double attack = juce::jmin(1.0, inSyllable / 0.02);
+                const double release = juce::jmin(1.0, (syllableSeconds - inSyllable) / 0.04);
+                voice *= 0.25 * attack * release;
+            }
+
+            // Consonant burst over the first 15 ms of every syllable
+            const double burst = inSyllable < 0.015 ? 0.08 * (1.0 - inSyllable / 0.015) : 0.0;
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                const double air = noise[channel].next() * (burst + 0.002);
+                signal.setSample(channel, i, (float)(voice + air));
+            }
+        }
+
+        return signal;
+    }
+
+    //==========================================================================
+    // The RubberBand modules. Their references (and the full engine's) can only
+    // be recorded from a Release build with the bundled RubberBand linked, so
+    // until those are committed they only run in the real-time check.
+    std::vector<TestCase> makeShifterCases()
+    {
+        return {
+            { "pitch-drift-brain", [](VocalProcessor& p) {
+                  auto& m = p.getPitchDriftBrain();
+                  m.setCentsLow(-40.0f); m.setCentsHigh(40.0f); m.setLFOSpeed(0.5f); m.setEnabled(true); } },
+            { "formant-whispers", [](VocalProcessor& p) {
+                  auto& m = p.getFormantWhispers();
+                  m.setFormantShiftLow(-2.0f); m.setFormantShiftHigh(2.0f); m.setFormantLFOSpeed(0.5f); m.setEnabled(true); } },
+        };
+    }
+
+    // One case per module with settings that exercise its main path. Ids
+    // double as reference file names.
+    std::vector<TestCase> makeTestCases()
+    {
+        return {
+            { "breath-noise-engine", [](VocalProcessor& p) {
+                  auto& m = p.getBreathNoiseEngine();
+                  m.setBreathIntensity(0.6f); m.setEnabled(true); } },
+            { "timing-wobble", [](VocalProcessor& p) {
+                  auto& m = p.getTimingWobble();
+                  m.setWobbleAmount(0.7f); m.setSwingFeel(0.3f); m.setEnabled(true); } },
+            { "volume-personality", [](VocalProcessor& p) {
+                  auto& m = p.getVolumePersonality();
+                  m.setIntensity(0.7f); m.setEnabled(true); } },
+            { "porcelain-reflections", [](VocalProcessor& p) {
+                  auto& m = p.getPorcelainReflections();
+                  m.setTileScatter(0.7f); m.setEdgeSlap(0.5f); m.setLateLevel(0.5f); m.setTailLength(1.2f); m.setEnabled(true); } },
+            { "steam-modulator", [](VocalProcessor& p) {
+                  auto& m = p.getSteamModulator();
+                  m.setHumidity(0.6f); m.setEnabled(true); } },
+            { "faucet-flutter", [](VocalProcessor& p) {
+                  auto& m = p.getFaucetFlutter();
+                  m.setWaterPressure(0.6f); m.setColdWater(0.4f); m.setDripAmount(0.5f); m.setEnabled(true); } },
+            { "drain-resonator", [](VocalProcessor& p) {
+                  auto& m = p.getDrainResonator();
+                  m.setResonance(0.6f); m.setHumLevel(0.3f); m.setEnabled(true); } },
+            { "rubber-duck-fm", [](VocalProcessor& p) {
+                  auto& m = p.getRubberDuckFM();
+                  m.setQuackIntensity(0.6f); m.setEnabled(true); } },
+            { "soap-bar-glitch", [](VocalProcessor& p) {
+                  auto& m = p.getSoapBarGlitch();
+                  m.setSlipperiness(0.6f); m.setSoapyBlur(0.4f); m.setEnabled(true); } },
+            { "bathroom-fan-chorus", [](VocalProcessor& p) {
+                  auto& m = p.getBathroomFanChorus();
+                  m.setFanAmount(0.6f); m.setFanSpeed(0.5f); m.setNumVoices(3); m.setEnabled(true); } },
+            { "mildewy-wall-filter", [](VocalProcessor& p) {
+                  auto& m = p.getMildewyWallFilter();
+                  m.setMildew(0.6f); m.setMoldburstRate(0.5f); m.setEnabled(true); } },
+            { "voice-identity-builder", [](VocalProcessor& p) {
+                  auto& m = p.getVoiceIdentityBuilder();
+                  m.setNumVoices(3); m.setDoubleLevel(0.6f); m.randomizeIdentities(7); m.setEnabled(true); } },
+        };
+    }
+
+    // Every module at once
+    TestCase makeFullEngineCase()
+    {
+        return { "full-engine", [](VocalProcessor& p) {
+                     for (const auto& cases : { makeShifterCases(), makeTestCases() })
+                         for (const auto& moduleCase : cases)
+                             moduleCase.configure(p); } };
+    }
+
+    //==========================================================================
+    // Renders the input through a freshly prepared processor in host-sized
+    // blocks; returns the processing time only (construction is not timed)
+    double render(const TestCase& testCase, const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output)
+    {
+        auto processor = std::make_unique<VocalProcessor>();
+        processor->setSeed(testSeed);
+        processor->setMasterMix(1.0f);
+        testCase.configure(*processor);
+        processor->prepare(sampleRate, hostBlockSize);
+
+        output.setSize(2, numSamples);
+        for (int channel = 0; channel < 2; ++channel)
+            output.copyFrom(channel, 0, input, channel, 0, numSamples);
+
+        juce::AudioBuffer<float> block;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int offset = 0; offset < numSamples; offset += hostBlockSize)
+        {
+            block.setDataToReferTo(output.getArrayOfWritePointers(), 2, offset, juce::jmin(hostBlockSize, numSamples - offset));
+            processor->process(block);
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Per window: RMS of left, right and side, RMS of the mid signal's first
+    // difference (tracks spectral tilt, which the plain levels miss) and the
+    // mid signal's spectral centroid. Levels alone cannot tell a pitch or
+    // formant shift from dry audio; the centroid moves with either.
+    Fingerprint makeFingerprint(const juce::AudioBuffer<float>& output)
+    {
+        Fingerprint fingerprint;
+        const auto* left = output.getReadPointer(0);
+        const auto* right = output.getReadPointer(1);
+        float previousMid = 0.0f;
+
+        juce::dsp::FFT fft(fingerprintOrder);
+        std::vector<float> spectrum((size_t)(2 * fingerprintWindow));
+
+        for (int start = 0; start + fingerprintWindow <= numSamples; start += fingerprintWindow)
+        {
+            double sumLeft = 0.0, sumRight = 0.0, sumSide = 0.0, sumSlope = 0.0, sumMid = 0.0;
+            std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+
+            for (int i = start; i < start + fingerprintWindow; ++i)
+            {
+                const float mid = 0.5f * (left[i] + right[i]);
+                const float side = 0.5f * (left[i] - right[i]);
+                sumLeft += (double)left[i] * left[i];
+                sumRight += (double)right[i] * right[i];
+                sumSide += (double)side * side;
+                sumSlope += (double)(mid - previousMid) * (mid - previousMid);
+                sumMid += (double)mid * mid;
+                previousMid = mid;
+
+                const double hann = 0.5 - 0.5 * std::cos(twoPi * (i - start) / fingerprintWindow);
+                spectrum[(size_t)(i - start)] = (float)(mid * hann);
+            }
+
+            // Near-silent windows get 0: their centroid is just the noise floor
+            double centroid = 0.0;
+            if (std::sqrt(sumMid / fingerprintWindow) > centroidGate)
+            {
+                fft.performFrequencyOnlyForwardTransform(spectrum.data(), true);
+
+                double weighted = 0.0, total = 0.0;
+                for (int bin = 1; bin <= fingerprintWindow / 2; ++bin)
+                {
+                    weighted += bin * (double)spectrum[(size_t)bin];
+                    total += spectrum[(size_t)bin];
+                }
+
+                centroid = total > 0.0 ? weighted / total * sampleRate / fingerprintWindow : 0.0;
+            }
+
+            fingerprint.push_back({ std::sqrt(sumLeft / fingerprintWindow), std::sqrt(sumRight / fingerprintWindow),
+                                    std::sqrt(sumSide / fingerprintWindow), std::sqrt(sumSlope / fingerprintWindow),
+                                    centroid });
+        }
+
+        return fingerprint;
+    }
+
+    //==========================================================================
+    // Reference files: '#' comment lines, then one whitespace-separated row per entry
+    std::vector<std::vector<std::string>> readRows(const std::filesystem::path& file)
+    {
+        std::vector<std::vector<std::string>> rows;
+        std::ifstream stream(file);
+        std::string line;
+
+        while (std::getline(stream, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream fields(line);
+            std::vector<std::string> row;
+            for (std::string field; fields >> field;)
+                row.push_back(field);
+            rows.push_back(row);
+        }
+
+        return rows;
+    }
+
+    bool writeFingerprint(const std::filesystem::path& file, const std::string& id, const Fingerprint& fingerprint)
+    {
+        std::ofstream stream(file);
+        stream << "# Schlomo engine golden fingerprint: " << id << "\n"
+               << "# " << sampleRate << " Hz, " << numSamples << " samples, seed " << testSeed
+               << ", window " << fingerprintWindow << "\n"
+               << "# rmsLeft rmsRight rmsSide rmsSlope centroidHz\n";
+
+        char line[160];
+        for (const auto& row : fingerprint)
+        {
+            std::snprintf(line, sizeof(line), "%.9g %.9g %.9g %.9g %.9g\n", row[0], row[1], row[2], row[3], row[4]);
+            stream << line;
+        }
+
+        return (bool)stream;
+    }
+
+    // Returns an empty string when the fingerprint matches the reference
+    std::string compareFingerprint(const Fingerprint& actual, const std::vector<std::vector<std::string>>& reference)
+    {
+        static const char* const columns[] = { "rmsLeft", "rmsRight", "rmsSide", "rmsSlope", "centroidHz" };
+
+        if (reference.size() != actual.size())
+            return "reference has " + std::to_string(reference.size()) + " windows, render has " + std::to_string(actual.size());
+
+        for (size_t window = 0; window < actual.size(); ++window)
+        {
+            if (reference[window].size() != actual[window].size())
+                return "malformed reference row " + std::to_string(window);
+
+            for (size_t column = 0; column < actual[window].size(); ++column)
+            {
+                const double expected = std::atof(reference[window][column].c_str());
+                const double value = actual[window][column];
+
+                if (! std::isfinite(value) || std::abs(value - expected) > absoluteTolerance + relativeTolerance * std::abs(expected))
+                {
+                    char message[160];
+                    std::snprintf(message, sizeof(message), "window %d (%.3f s) %s: expected %.6g, got %.6g",
+                                  (int)window, window * fingerprintWindow / sampleRate, columns[column], expected, value);
+                    return message;
+                }
+            }
+        }
+
+        return {};
+    }
+
+    //==========================================================================
+    int runGolden(const std::filesystem::path& referenceDir, bool update)
+    {
+        const auto input = makeSyntheticVocal();
+        int failures = 0;
+
+        for (const auto& testCase : makeTestCases())
+        {
+            juce::AudioBuffer<float> output;
+            render(testCase, input, output);
+            const auto fingerprint = makeFingerprint(output);
+            const auto file = referenceDir / (testCase.id + ".txt");
+
+            if (update)
+            {
+                const bool written = writeFingerprint(file, testCase.id, fingerprint);
+                std::printf("%s %-24s %s\n", written ? "RECORD " : "FAIL   ", testCase.id.c_str(), file.string().c_str());
+                failures += written ? 0 : 1;
+                continue;
+            }
+
+            const auto mismatch = std::filesystem::exists(file) ? compareFingerprint(fingerprint, readRows(file))
+                                                                : std::string(missingReference);
+            std::printf("%s %-24s %s\n", mismatch.empty() ? "PASS   " : "FAIL   ", testCase.id.c_str(), mismatch.c_str());
+            failures += mismatch.empty() ? 0 : 1;
+        }
+
+        return failures > 0 ? exitFailed : exitPassed;
+    }
+
+    int runPerformance(const std::filesystem::path& referenceDir, bool update)
+    {
+       #if ! defined (NDEBUG)
+        if (! update)
+        {
+            std::printf("Performance budgets are only checked in optimised builds\n");
+            return exitSkipped;
+        }
+       #endif
+
+        // Budgets are per machine class; scale them on slower CI runners
+        double budgetScale = 1.0;
+        if (const char* scale = std::getenv("SCHLOMO_PERF_BUDGET_SCALE"))
+            budgetScale = juce::jmax(0.1, std::atof(scale));
+
+        const auto budgetFile = referenceDir / "budgets.txt";
+        std::map<std::string, double> budgets;
+        for (const auto& row : readRows(budgetFile))
+            if (row.size() == 2)
+                budgets[row[0]] = std::atof(row[1].c_str());
+
+        const auto input = makeSyntheticVocal();
+        std::map<std::string, double> measured;
+        int failures = 0;
+
+        for (const auto& testCase : makeTestCases())
+        {
+            // Best of several runs: the least disturbed one is the closest to the real cost
+            juce::AudioBuffer<float> output;
+            double best = render(testCase, input, output);
+            for (int repeat = 1; repeat < performanceRepeats; ++repeat)
+                best = std::min(best, render(testCase, input, output));
+
+            const double nsPerSample = best * 1.0e9 / numSamples;
+            const auto budget = budgets.find(testCase.id);
+
+            if (update)
+            {
+                measured[testCase.id] = nsPerSample * budgetHeadroom;
+                std::printf("RECORD  %-24s %8.1f ns/sample (budget %.1f)\n", testCase.id.c_str(), nsPerSample, nsPerSample * budgetHeadroom);
+                continue;
+            }
+
+            if (budget == budgets.end())
+            {
+                std::printf("FAIL    %-24s %8.1f ns/sample (%s)\n", testCase.id.c_str(), nsPerSample, missingReference);
+                ++failures;
+                continue;
+            }
+
+            const double limit = budget->second * budgetScale;
+            const bool withinBudget = nsPerSample <= limit;
+            std::printf("%s %-24s %8.1f ns/sample (budget %.1f)\n", withinBudget ? "PASS   " : "FAIL   ",
+                        testCase.id.c_str(), nsPerSample, limit);
+            failures += withinBudget ? 0 : 1;
+        }
+
+        if (update)
+        {
+            std::ofstream stream(budgetFile);
+            stream << "# Schlomo engine performance budgets: <case> <ns per stereo sample>\n"
+                   << "# Recorded at " << budgetHeadroom << "x the measured cost; scale with SCHLOMO_PERF_BUDGET_SCALE\n";
+
+            char line[128];
+            for (const auto& [id, nsPerSample] : measured)
+            {
+                std::snprintf(line, sizeof(line), "%s %.1f\n", id.c_str(), nsPerSample);
+                stream << line;
+            }
+
+            if (! stream)
+            {
+                std::printf("FAIL    could not write %s\n", budgetFile.string().c_str());
+                ++failures;
+            }
+        }
+
+        return failures > 0 ? exitFailed : exitPassed;
+    }
+
+    //==========================================================================
+    // Every module on, host blocks of awkward sizes through both process()
+    // overloads, then a tier change and an offline bounce mid-stream
+    int runRealtime()
+    {
+       #if ! SCHLOMO_REALTIME_CHECKS
+        std::printf("Built without SCHLOMO_REALTIME_CHECKS, so nothing would be intercepted\n");
+        return exitSkipped;
+       #else
+        static constexpr int blockSizes[] = { hostBlockSize, 1, 37, 64, 1000, 2048 };
+        constexpr int maxBlockSize = 2048;
+
+        const auto fullEngine = makeFullEngineCase();
+
+        auto processor = std::make_unique<VocalProcessor>();
+        processor->setSeed(testSeed);
+        fullEngine.configure(*processor);
+        processor->prepare(sampleRate, hostBlockSize);
+
+        auto buffer = makeSyntheticVocal();
+        juce::AudioBuffer<float> separateOutput(2, maxBlockSize);
+        juce::AudioBuffer<float> block;
+
+        // Only render() is checked; the harness may allocate between blocks
+        RealtimeSafety::clearViolations();
+
+        for (int offset = 0, index = 0; offset < numSamples; ++index)
+        {
+            if (offset >= numSamples / 3)
+                processor->setQuality(ProcessingQuality::Eco);
+            processor->setOfflineRendering(offset >= 2 * numSamples / 3);
+
+            const int length = juce::jmin(blockSizes[index % (int)std::size(blockSizes)], numSamples - offset);
+            block.setDataToReferTo(buffer.getArrayOfWritePointers(), 2, offset, length);
+
+            if (index % 2 == 0)
+            {
+                processor->process(block);
+            }
+            else
+            {
+                const juce::dsp::AudioBlock<const float> input(block);
+                auto output = juce::dsp::AudioBlock<float>(separateOutput).getSubBlock(0, (size_t)length);
+                processor->process(juce::dsp::ProcessContextNonReplacing<float>(input, output));
+            }
+
+            offset += length;
+        }
+
+        const int numViolations = RealtimeSafety::getNumViolations();
+        for (int i = 0; i < juce::jmin(numViolations, RealtimeSafety::maxRecordedViolations); ++i)
+            std::printf("        %s\n", RealtimeSafety::describe(RealtimeSafety::getViolation(i)).toRawUTF8());
+
+        std::printf("%s %-24s %d violation(s)\n", numViolations == 0 ? "PASS   " : "FAIL   ", fullEngine.id.c_str(), numViolations);
+        return numViolations == 0 ? exitPassed : exitFailed;
+       #endif
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && std::strcmp(argv[1], "realtime") == 0)
+        return runRealtime();
+
+    if (argc < 3)
+    {
+        std::printf("Usage: %s <golden|performance> <referenceDir> [--update]\n"
+                    "       %s realtime\n", argv[0], argv[0]);
+        return exitFailed;
+    }
+
+    const std::string mode = argv[1];
+    const std::filesystem::path referenceDir = argv[2];
+    const bool update = argc > 3 && std::strcmp(argv[3], "--update") == 0;
+
+    // Only an explicit update writes; a normal run leaves the tree alone
+    if (update)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(referenceDir, error);
+    }
+
+    if (mode == "golden")
+        return runGolden(referenceDir, update);
+
+    if (mode == "performance")
+        return runPerformance(referenceDir, update);
+
+    std::printf("Unknown mode '%s'\n", mode.c_str());
+    return exitFailed;
+}
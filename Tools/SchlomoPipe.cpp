@@ -0,0 +1,781 @@
+//==============================================================================
+// Schlomo Pipe
+// Long-lived streaming front end for VocalProcessor: reads interleaved raw PCM
+// from stdin (or from each client of a local socket), writes the processed
+// audio back in the same format, and follows a control file for parameters.
+//
+// Reading and writing run on their own threads, each double-buffered against
+// the DSP loop, so VocalProcessor never waits on a read() or write().
+//
+//   cmake -B build -DSCHLOMO_BUILD_PLUGIN=OFF -DSCHLOMO_BUILD_PIPE=ON
+//   cmake --build build --target SchlomoPipe
+//   sox vocal.wav -t f32 - | ./build/SchlomoPipe --control bath.conf > wet.f32
+//   ./build/SchlomoPipe --socket /tmp/schlomo.sock --format s16 --channels 1
+//
+// Control file ("key = value", '#' comments, re-read whenever it changes):
+//   mix = 0.6
+//   seed = 1234
+//   quality = high                      # eco, standard, high
+//   porcelain-reflections.enabled = on
+//   porcelain-reflections.tile-scatter = 0.7
+// Keys are <module>.<parameter>; run with --list-parameters for all of them.
+//==============================================================================
+#include "VocalProcessor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    //==========================================================================
+    // Raw PCM formats (always little-endian, interleaved)
+    enum class SampleFormat { Float32, Int16, Int24, Int32 };
+
+    int getBytesPerSample(SampleFormat format)
+    {
+        switch (format)
+        {
+            case SampleFormat::Int16: return 2;
+            case SampleFormat::Int24: return 3;
+            case SampleFormat::Float32:
+            case SampleFormat::Int32: break;
+        }
+
+        return 4;
+    }
+
+    void decodeSamples(const char* source, float* dest, int numSamples, SampleFormat format)
+    {
+        const int stride = getBytesPerSample(format);
+
+        for (int i = 0; i < numSamples; ++i, source += stride)
+        {
+            switch (format)
+            {
+                case SampleFormat::Float32:
+                {
+                    const auto bits = juce::ByteOrder::littleEndianInt(source);
+                    std::memcpy(dest + i, &bits, sizeof(float));
+                    break;
+                }
+                case SampleFormat::Int16: dest[i] = (float)(juce::int16)juce::ByteOrder::littleEndianShort(source) / 32768.0f; break;
+                case SampleFormat::Int24: dest[i] = (float)juce::ByteOrder::littleEndian24Bit(source) / 8388608.0f; break;
+                case SampleFormat::Int32: dest[i] = (float)((double)(juce::int32)juce::ByteOrder::littleEndianInt(source) / 2147483648.0); break;
+            }
+        }
+    }
+
+    void encodeSamples(const float* source, char* dest, int numSamples, SampleFormat format)
+    {
+        const int stride = getBytesPerSample(format);
+
+        for (int i = 0; i < numSamples; ++i, dest += stride)
+        {
+            const float clipped = juce::jlimit(-1.0f, 1.0f, source[i]);
+
+            switch (format)
+            {
+                case SampleFormat::Float32:
+                {
+                    juce::uint32 bits;
+                    std::memcpy(&bits, source + i, sizeof(float));
+                    bits = juce::ByteOrder::swapIfBigEndian(bits);
+                    std::memcpy(dest, &bits, sizeof(bits));
+                    break;
+                }
+                case SampleFormat::Int16:
+                {
+                    const auto value = juce::ByteOrder::swapIfBigEndian((juce::uint16)(juce::int16)juce::jlimit(-32768, 32767, juce::roundToInt(clipped * 32768.0f)));
+                    std::memcpy(dest, &value, sizeof(value));
+                    break;
+                }
+                case SampleFormat::Int24:
+                    juce::ByteOrder::littleEndian24BitToChars(juce::jlimit(-8388608, 8388607, juce::roundToInt(clipped * 8388608.0f)), dest);
+                    break;
+                case SampleFormat::Int32:
+                {
+                    const auto value = juce::ByteOrder::swapIfBigEndian((juce::uint32)(juce::int32)juce::jlimit(-2147483648.0, 2147483647.0, (double)clipped * 2147483648.0));
+                    std::memcpy(dest, &value, sizeof(value));
+                    break;
+                }
+            }
+        }
+    }
+
+    //==========================================================================
+    // Single-producer/single-consumer queue of fixed-size interleaved blocks.
+    // With two slots the I/O thread fills (or drains) one block while the DSP
+    // loop works on the other.
+    class BlockFifo
+    {
+    public:
+        BlockFifo(int numSlots, int samplesPerSlot)
+            : fifo(numSlots + 1),  // AbstractFifo keeps one slot free
+              slots((size_t)(numSlots + 1), std::vector<float>((size_t)samplesPerSlot)),
+              slotFrames((size_t)(numSlots + 1), 0)
+        {
+        }
+
+        // Producer side: nullptr once the consumer has gone away
+        float* waitForFreeSlot()
+        {
+            while (fifo.getFreeSpace() == 0)
+            {
+                if (closed.load())
+                    return nullptr;
+                spaceAvailable.wait(50);
+            }
+
+            int start1, size1, start2, size2;
+            fifo.prepareToWrite(1, start1, size1, start2, size2);
+            writeSlot = start1;
+            return slots[(size_t)start1].data();
+        }
+
+        void finishWrite(int numFrames)
+        {
+            slotFrames[(size_t)writeSlot] = numFrames;
+            fifo.finishedWrite(1);
+            dataAvailable.signal();
+        }
+
+        void markEndOfStream()
+        {
+            endOfStream = true;
+            dataAvailable.signal();
+        }
+
+        // Consumer side: nullptr once the stream has ended and every block was read
+        const float* waitForFilledSlot(int& numFrames)
+        {
+            while (fifo.getNumReady() == 0)
+            {
+                if (endOfStream.load() && fifo.getNumReady() == 0)
+                    return nullptr;
+                dataAvailable.wait(50);
+            }
+
+            int start1, size1, start2, size2;
+            fifo.prepareToRead(1, start1, size1, start2, size2);
+            numFrames = slotFrames[(size_t)start1];
+            return slots[(size_t)start1].data();
+        }
+
+        void finishRead()
+        {
+            fifo.finishedRead(1);
+            spaceAvailable.signal();
+        }
+
+        // Consumer gave up (e.g. the output was closed); unblocks the producer
+        void close()
+        {
+            closed = true;
+            spaceAvailable.signal();
+        }
+
+    private:
+        juce::AbstractFifo fifo;
+        std::vector<std::vector<float>> slots;
+        std::vector<int> slotFrames;
+        int writeSlot = 0;
+        std::atomic<bool> endOfStream { false }, closed { false };
+        juce::WaitableEvent spaceAvailable, dataAvailable;
+    };
+
+    //==========================================================================
+    struct StreamFormat
+    {
+        SampleFormat format = SampleFormat::Float32;
+        int numChannels = 2;
+        double sampleRate = 48000.0;
+        int blockFrames = 256;
+
+        int getFrameBytes() const { return getBytesPerSample(format) * numChannels; }
+    };
+
+    // Reads whole blocks from a file descriptor, polling so a stop request is
+    // honoured even while the upstream is silent
+    class PcmReader : public juce::Thread
+    {
+    public:
+        PcmReader(int fd, const StreamFormat& streamFormat, BlockFifo& destination)
+            : juce::Thread("Schlomo Pipe Reader"), inputFd(fd), stream(streamFormat), fifo(destination),
+              bytes((size_t)(streamFormat.blockFrames * streamFormat.getFrameBytes()))
+        {
+        }
+
+        void run() override
+        {
+            const int frameBytes = stream.getFrameBytes();
+            bool endOfInput = false;
+
+            while (! endOfInput && ! threadShouldExit())
+            {
+                auto* slot = fifo.waitForFreeSlot();
+                if (slot == nullptr)
+                    break;
+
+                // Fill a whole block; only the end of the stream may deliver a short one
+                size_t filled = 0;
+                while (filled < bytes.size() && ! threadShouldExit())
+                {
+                    pollfd request { inputFd, POLLIN, 0 };
+                    if (poll(&request, 1, 100) <= 0)
+                        continue;
+
+                    const auto received = read(inputFd, bytes.data() + filled, bytes.size() - filled);
+                    if (received < 0 && errno == EINTR)
+                        continue;
+
+                    if (received <= 0)
+                    {
+                        endOfInput = true;
+                        break;
+                    }
+
+                    filled += (size_t)received;
+                }
+
+                const int numFrames = (int)(filled / (size_t)frameBytes);
+                if (numFrames > 0)
+                {
+                    decodeSamples(bytes.data(), slot, numFrames * stream.numChannels, stream.format);
+                    fifo.finishWrite(numFrames);
+                }
+            }
+
+            fifo.markEndOfStream();
+        }
+
+    private:
+        const int inputFd;
+        const StreamFormat stream;
+        BlockFifo& fifo;
+        std::vector<char> bytes;
+    };
+
+    class PcmWriter : public juce::Thread
+    {
+    public:
+        PcmWriter(int fd, const StreamFormat& streamFormat, BlockFifo& source)
+            : juce::Thread("Schlomo Pipe Writer"), outputFd(fd), stream(streamFormat), fifo(source),
+              bytes((size_t)(streamFormat.blockFrames * streamFormat.getFrameBytes()))
+        {
+        }
+
+        void run() override
+        {
+            int numFrames = 0;
+
+            while (auto* block = fifo.waitForFilledSlot(numFrames))
+            {
+                encodeSamples(block, bytes.data(), numFrames * stream.numChannels, stream.format);
+                fifo.finishRead();
+
+                const size_t total = (size_t)(numFrames * stream.getFrameBytes());
+                for (size_t written = 0; written < total;)
+                {
+                    const auto sent = write(outputFd, bytes.data() + written, total - written);
+                    if (sent < 0 && errno == EINTR)
+                        continue;
+
+                    if (sent <= 0)
+                    {
+                        failed = true;
+                        fifo.close();
+                        return;
+                    }
+
+                    written += (size_t)sent;
+                }
+            }
+        }
+
+        bool hasFailed() const { return failed.load(); }
+
+    private:
+        const int outputFd;
+        const StreamFormat stream;
+        BlockFifo& fifo;
+        std::vector<char> bytes;
+        std::atomic<bool> failed { false };
+    };
+
+    //==========================================================================
+    // Control file: "<module>.<parameter> = value" plus the global keys
+    using Setting = std::pair<juce::String, juce::String>;
+    using ParameterSetter = std::function<void(VocalProcessor&, float)>;
+
+    template <typename Module>
+    void addModule(std::map<juce::String, ParameterSetter>& table, const juce::String& id, Module& (VocalProcessor::*getModule)(),
+                   std::initializer_list<std::pair<const char*, std::function<void(Module&, float)>>> parameters)
+    {
+        table[id + ".enabled"] = [getModule](VocalProcessor& p, float v) { (p.*getModule)().setEnabled(v >= 0.5f); };
+        table[id + ".mix"] = [getModule](VocalProcessor& p, float v) { (p.*getModule)().setMix(v); };
+
+        for (const auto& [name, setter] : parameters)
+            table[id + "." + name] = [getModule, setter = setter](VocalProcessor& p, float v) { setter((p.*getModule)(), v); };
+    }
+
+    const std::map<juce::String, ParameterSetter>& getParameterTable()
+    {
+        static const auto table = []
+        {
+            std::map<juce::String, ParameterSetter> t;
+            using P = VocalProcessor;
+
+            addModule<PitchDriftBrain>(t, "pitch-drift-brain", &P::getPitchDriftBrain, {
+                { "cents-low", [](PitchDriftBrain& m, float v) { m.setCentsLow(v); } },
+                { "cents-high", [](PitchDriftBrain& m, float v) { m.setCentsHigh(v); } },
+                { "lfo-speed", [](PitchDriftBrain& m, float v) { m.setLFOSpeed(v); } },
+                { "randomize", [](PitchDriftBrain& m, float v) { m.setRandomizeMode(v >= 0.5f); } } });
+            addModule<FormantWhispers>(t, "formant-whispers", &P::getFormantWhispers, {
+                { "shift-low", [](FormantWhispers& m, float v) { m.setFormantShiftLow(v); } },
+                { "shift-high", [](FormantWhispers& m, float v) { m.setFormantShiftHigh(v); } },
+                { "lfo-speed", [](FormantWhispers& m, float v) { m.setFormantLFOSpeed(v); } },
+                { "randomize", [](FormantWhispers& m, float v) { m.setFormantRandomizeMode(v >= 0.5f); } } });
+            addModule<BreathNoiseEngine>(t, "breath-noise-engine", &P::getBreathNoiseEngine, {
+                { "intensity", [](BreathNoiseEngine& m, float v) { m.setBreathIntensity(v); } },
+                { "huff", [](BreathNoiseEngine& m, float v) { m.setHuffMode(v >= 0.5f); } } });
+            addModule<TimingWobble>(t, "timing-wobble", &P::getTimingWobble, {
+                { "amount", [](TimingWobble& m, float v) { m.setWobbleAmount(v); } },
+                { "swing", [](TimingWobble& m, float v) { m.setSwingFeel(v); } } });
+            addModule<VolumePersonality>(t, "volume-personality", &P::getVolumePersonality, {
+                { "personality", [](VolumePersonality& m, float v) { m.setPersonality((VolumePersonality::PersonalityType)juce::roundToInt(v)); } },
+                { "intensity", [](VolumePersonality& m, float v) { m.setIntensity(v); } } });
+            addModule<PorcelainReflections>(t, "porcelain-reflections", &P::getPorcelainReflections, {
+                { "tile-scatter", [](PorcelainReflections& m, float v) { m.setTileScatter(v); } },
+                { "edge-slap", [](PorcelainReflections& m, float v) { m.setEdgeSlap(v); } },
+                { "late-level", [](PorcelainReflections& m, float v) { m.setLateLevel(v); } },
+                { "tail-length", [](PorcelainReflections& m, float v) { m.setTailLength(v); } } });
+            addModule<SteamModulator>(t, "steam-modulator", &P::getSteamModulator, {
+                { "humidity", [](SteamModulator& m, float v) { m.setHumidity(v); } },
+                { "fog", [](SteamModulator& m, float v) { m.setFogMode(v >= 0.5f); } } });
+            addModule<FaucetFlutter>(t, "faucet-flutter", &P::getFaucetFlutter, {
+                { "water-pressure", [](FaucetFlutter& m, float v) { m.setWaterPressure(v); } },
+                { "cold-water", [](FaucetFlutter& m, float v) { m.setColdWater(v); } },
+                { "drip", [](FaucetFlutter& m, float v) { m.setDripAmount(v); } } });
+            addModule<DrainResonator>(t, "drain-resonator", &P::getDrainResonator, {
+                { "resonance", [](DrainResonator& m, float v) { m.setResonance(v); } },
+                { "hum-level", [](DrainResonator& m, float v) { m.setHumLevel(v); } },
+                { "hum-frequency", [](DrainResonator& m, float v) { m.setHumFrequency(v); } },
+                { "clog", [](DrainResonator& m, float v) { m.setClogMode(v >= 0.5f); } } });
+            addModule<RubberDuckFM>(t, "rubber-duck-fm", &P::getRubberDuckFM, {
+                { "mode", [](RubberDuckFM& m, float v) { m.setQuackMode((RubberDuckFM::QuackMode)juce::roundToInt(v)); } },
+                { "intensity", [](RubberDuckFM& m, float v) { m.setQuackIntensity(v); } } });
+            addModule<SoapBarGlitch>(t, "soap-bar-glitch", &P::getSoapBarGlitch, {
+                { "slipperiness", [](SoapBarGlitch& m, float v) { m.setSlipperiness(v); } },
+                { "blur", [](SoapBarGlitch& m, float v) { m.setSoapyBlur(v); } } });
+            addModule<BathroomFanChorus>(t, "bathroom-fan-chorus", &P::getBathroomFanChorus, {
+                { "amount", [](BathroomFanChorus& m, float v) { m.setFanAmount(v); } },
+                { "speed", [](BathroomFanChorus& m, float v) { m.setFanSpeed(v); } },
+                { "voices", [](BathroomFanChorus& m, float v) { m.setNumVoices(juce::roundToInt(v)); } },
+                { "broken", [](BathroomFanChorus& m, float v) { m.setBrokenFan(v >= 0.5f); } } });
+            addModule<MildewyWallFilter>(t, "mildewy-wall-filter", &P::getMildewyWallFilter, {
+                { "mildew", [](MildewyWallFilter& m, float v) { m.setMildew(v); } },
+                { "moldburst-rate", [](MildewyWallFilter& m, float v) { m.setMoldburstRate(v); } } });
+            addModule<VoiceIdentityBuilder>(t, "voice-identity-builder", &P::getVoiceIdentityBuilder, {
+                { "voices", [](VoiceIdentityBuilder& m, float v) { m.setNumVoices(juce::roundToInt(v)); } },
+                { "level", [](VoiceIdentityBuilder& m, float v) { m.setDoubleLevel(v); } },
+                { "identity-seed", [](VoiceIdentityBuilder& m, float v) { m.randomizeIdentities((juce::uint32)v); } } });
+
+            t["mix"] = [](VocalProcessor& p, float v) { p.setMasterMix(v); };
+            return t;
+        }();
+
+        return table;
+    }
+
+    std::vector<Setting> parseControlFile(const juce::String& text)
+    {
+        std::vector<Setting> settings;
+
+        for (auto line : juce::StringArray::fromLines(text))
+        {
+            line = line.upToFirstOccurrenceOf("#", false, false).trim();
+            if (line.isEmpty())
+                continue;
+
+            const auto key = line.upToFirstOccurrenceOf("=", false, false).trim().toLowerCase();
+            const auto value = line.fromFirstOccurrenceOf("=", false, false).trim().toLowerCase();
+            if (key.isNotEmpty() && value.isNotEmpty())
+                settings.emplace_back(key, value);
+        }
+
+        return settings;
+    }
+
+    float parseValue(const juce::String& value)
+    {
+        if (value == "on" || value == "true" || value == "yes")
+            return 1.0f;
+        if (value == "off" || value == "false" || value == "no")
+            return 0.0f;
+        return value.getFloatValue();
+    }
+
+    bool parseQuality(const juce::String& value, ProcessingQuality& quality)
+    {
+        static const std::map<juce::String, ProcessingQuality> names {
+            { "eco", ProcessingQuality::Eco }, { "0", ProcessingQuality::Eco },
+            { "standard", ProcessingQuality::Standard }, { "1", ProcessingQuality::Standard },
+            { "high", ProcessingQuality::High }, { "2", ProcessingQuality::High } };
+
+        const auto found = names.find(value);
+        if (found == names.end())
+            return false;
+
+        quality = found->second;
+        return true;
+    }
+
+    // Polls the control file. Module parameters are applied on this thread
+    // (like the plugin's editor, so a module switched on builds its heavy state
+    // here); the engine-wide rest goes to the DSP loop, which picks it up
+    // between blocks without ever blocking on this thread.
+    class ControlFileWatcher : public juce::Thread
+    {
+    public:
+        // applyParameter returns false for settings that must wait for the DSP loop
+        ControlFileWatcher(const juce::File& fileToWatch, std::function<bool(const Setting&)> parameterHandler)
+            : juce::Thread("Schlomo Pipe Control"), file(fileToWatch), applyParameter(std::move(parameterHandler))
+        {
+            reload();  // Settings are in place before the first block
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait(250);
+                reload();
+            }
+        }
+
+        // DSP side: true (and the new settings) when a fresh parse is waiting
+        bool takeSettings(std::vector<Setting>& settings)
+        {
+            if (! hasPending.load())
+                return false;
+
+            std::unique_lock<std::mutex> lock(pendingLock, std::try_to_lock);
+            if (! lock.owns_lock())
+                return false;
+
+            settings.swap(pending);
+            hasPending = false;
+            return true;
+        }
+
+    private:
+        void reload()
+        {
+            const auto modified = file.getLastModificationTime();
+            if (! file.existsAsFile() || modified == lastModified)
+                return;
+
+            lastModified = modified;
+            auto settings = parseControlFile(file.loadFileAsString());
+            settings.erase(std::remove_if(settings.begin(), settings.end(), applyParameter), settings.end());
+
+            std::lock_guard<std::mutex> lock(pendingLock);
+            pending = std::move(settings);
+            hasPending = true;
+        }
+
+        const juce::File file;
+        const std::function<bool(const Setting&)> applyParameter;
+        juce::Time lastModified;
+        std::mutex pendingLock;
+        std::vector<Setting> pending;
+        std::atomic<bool> hasPending { false };
+    };
+
+    //==========================================================================
+    class PipeEngine
+    {
+    public:
+        PipeEngine(const StreamFormat& streamFormat, ProcessingQuality initialQuality, juce::uint64 seed)
+            : stream(streamFormat)
+        {
+            processor.setSeed(seed);
+            processor.setQuality(initialQuality);
+            processor.setOfflineRendering(false);
+            buffer.setSize(stream.numChannels, stream.blockFrames);
+        }
+
+        // After the initial settings, so modules that start active have their
+        // heavy state built here instead of arriving a few blocks into the stream
+        void prepare()
+        {
+            processor.prepare(stream.sampleRate, stream.blockFrames);
+            windowChangePending = false;
+        }
+
+        // Control thread: module parameters, which are safe to set while the DSP
+        // loop runs. False for the settings applySettings() handles.
+        bool applyParameter(const Setting& setting)
+        {
+            const auto& [key, value] = setting;
+            if (key == "seed" || key == "quality")
+                return false;
+
+            const auto& table = getParameterTable();
+            if (const auto setter = table.find(key); setter != table.end())
+                setter->second(processor, parseValue(value));
+            else
+                std::fprintf(stderr, "SchlomoPipe: unknown control '%s'\n", key.toRawUTF8());
+
+            return true;
+        }
+
+        // DSP thread, between blocks
+        void applySettings(const std::vector<Setting>& settings)
+        {
+            for (const auto& [key, value] : settings)
+            {
+                if (key == "seed")
+                {
+                    processor.setSeed((juce::uint64)value.getLargeIntValue());
+                }
+                else if (key == "quality")
+                {
+                    ProcessingQuality quality;
+                    if (! parseQuality(value, quality))
+                        std::fprintf(stderr, "SchlomoPipe: unknown quality '%s'\n", value.toRawUTF8());
+                    else if (quality != processor.getQuality())
+                    {
+                        // Modules switch at the next block. The shifter window (and
+                        // with it the latency) waits for the next stream, as the
+                        // plugin's waits for prepareToPlay: re-preparing here would
+                        // drop every tail mid-stream.
+                        processor.setQuality(quality);
+                        windowChangePending = true;
+                    }
+                }
+            }
+        }
+
+        // Processes one stream to completion; false if the output went away early
+        bool run(int inputFd, int outputFd, ControlFileWatcher* control)
+        {
+            BlockFifo input(2, stream.blockFrames * stream.numChannels);
+            BlockFifo output(2, stream.blockFrames * stream.numChannels);
+            PcmReader reader(inputFd, stream, input);
+            PcmWriter writer(outputFd, stream, output);
+            std::vector<Setting> settings;
+
+            // Between streams: a quality change made during the last one gets its shifter window
+            if (windowChangePending)
+                prepare();
+
+            reader.startThread();
+            writer.startThread();
+
+            int numFrames = 0;
+            while (auto* block = input.waitForFilledSlot(numFrames))
+            {
+                if (control != nullptr && control->takeSettings(settings))
+                    applySettings(settings);
+
+                // Refer to the first numFrames of the buffer sized up front; never reallocates
+                buffer.setSize(stream.numChannels, numFrames, false, false, true);
+                for (int channel = 0; channel < stream.numChannels; ++channel)
+                {
+                    auto* dest = buffer.getWritePointer(channel);
+                    for (int frame = 0; frame < numFrames; ++frame)
+                        dest[frame] = block[frame * stream.numChannels + channel];
+                }
+                input.finishRead();
+
+                processor.process(buffer);
+
+                auto* slot = output.waitForFreeSlot();
+                if (slot == nullptr)
+                    break;
+
+                for (int channel = 0; channel < stream.numChannels; ++channel)
+                {
+                    const auto* source = buffer.getReadPointer(channel);
+                    for (int frame = 0; frame < numFrames; ++frame)
+                        slot[frame * stream.numChannels + channel] = source[frame];
+                }
+                output.finishWrite(numFrames);
+            }
+
+            output.markEndOfStream();
+            writer.waitForThreadToExit(-1);
+            input.close();
+            reader.stopThread(1000);
+
+            // The next stream starts on a fresh timeline with the same settings
+            processor.reset();
+            return ! writer.hasFailed();
+        }
+
+    private:
+        const StreamFormat stream;
+        VocalProcessor processor;
+        juce::AudioBuffer<float> buffer;
+        bool windowChangePending = false;
+    };
+
+    //==========================================================================
+    int listenOnSocket(const juce::String& path)
+    {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if ((size_t)path.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+            return -1;
+
+        std::strcpy(address.sun_path, path.toRawUTF8());
+        unlink(address.sun_path);
+
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+            return -1;
+
+        if (bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 4) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    void printUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: SchlomoPipe [options]\n"
+            "  --format f32|s16|s24|s32   Raw little-endian PCM format (default f32)\n"
+            "  --channels 1|2             Interleaved channels (default 2)\n"
+            "  --rate <hz>                Sample rate (default 48000)\n"
+            "  --block <frames>           Frames per I/O block, the pipe's added latency (default 256)\n"
+            "  --control <file>           Parameter file, re-read whenever it changes\n"
+            "  --quality eco|standard|high\n"
+            "  --seed <n>                 Random seed (default 1)\n"
+            "  --socket <path>            Serve clients on a local socket instead of stdin/stdout\n"
+            "  --list-parameters          Print every control key and exit\n");
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    StreamFormat stream;
+    ProcessingQuality quality = ProcessingQuality::Standard;
+    juce::uint64 seed = 1;
+    juce::String controlPath, socketPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String option(argv[i]);
+        const juce::String value(i + 1 < argc ? argv[i + 1] : "");
+
+        if (option == "--list-parameters")
+        {
+            std::printf("mix\nseed\nquality\n");
+            for (const auto& entry : getParameterTable())
+                if (entry.first != "mix")
+                    std::printf("%s\n", entry.first.toRawUTF8());
+            return 0;
+        }
+
+        if (value.isEmpty())
+        {
+            printUsage();
+            return 1;
+        }
+
+        ++i;
+        if (option == "--format")
+        {
+            static const std::map<juce::String, SampleFormat> formats {
+                { "f32", SampleFormat::Float32 }, { "s16", SampleFormat::Int16 },
+                { "s24", SampleFormat::Int24 }, { "s32", SampleFormat::Int32 } };
+            const auto found = formats.find(value);
+            if (found == formats.end()) { printUsage(); return 1; }
+            stream.format = found->second;
+        }
+        else if (option == "--channels") stream.numChannels = juce::jlimit(1, 2, value.getIntValue());
+        else if (option == "--rate")     stream.sampleRate = juce::jlimit(8000.0, 192000.0, value.getDoubleValue());
+        else if (option == "--block")    stream.blockFrames = juce::jlimit(16, 8192, value.getIntValue());
+        else if (option == "--control")  controlPath = value;
+        else if (option == "--socket")   socketPath = value;
+        else if (option == "--seed")     seed = (juce::uint64)value.getLargeIntValue();
+        else if (option == "--quality")
+        {
+            if (! parseQuality(value.toLowerCase(), quality)) { printUsage(); return 1; }
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // A closed downstream shows up as a failed write, not a fatal signal
+    std::signal(SIGPIPE, SIG_IGN);
+
+    PipeEngine engine(stream, quality, seed);
+
+    std::unique_ptr<ControlFileWatcher> control;
+    if (controlPath.isNotEmpty())
+    {
+        control = std::make_unique<ControlFileWatcher>(juce::File::getCurrentWorkingDirectory().getChildFile(controlPath),
+                                                       [&engine](const Setting& setting) { return engine.applyParameter(setting); });
+
+        std::vector<Setting> settings;
+        if (control->takeSettings(settings))
+            engine.applySettings(settings);
+
+        control->startThread();
+    }
+
+    engine.prepare();
+
+    if (socketPath.isEmpty())
+        return engine.run(STDIN_FILENO, STDOUT_FILENO, control.get()) ? 0 : 1;
+
+    const int listener = listenOnSocket(socketPath);
+    if (listener < 0)
+    {
+        std::fprintf(stderr, "SchlomoPipe: cannot listen on %s: %s\n", socketPath.toRawUTF8(), std::strerror(errno));
+        return 1;
+    }
+
+    // One client at a time, each a complete stream; the process stays up between them
+    for (;;)
+    {
+        const int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        engine.run(client, client, control.get());
+        close(client);
+    }
+
+    close(listener);
+    return 1;
+}